@@ -0,0 +1,651 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/policies/map/storage/HashTable.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains HashTable
+ *
+ * \b HashTable
+ *
+ * Map storage based on a hash table with chained buckets.
+ * Lookups are lock-free. The table grows incrementally - without blocking readers.
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__concurrent_containers__policies__map__storage__HashTable_h__
+#define __rrlib__concurrent_containers__policies__map__storage__HashTable_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include <array>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "rrlib/thread/tLock.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tAdaptiveMutex.h"
+#include "rrlib/concurrent_containers/tGracePeriods.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+namespace map
+{
+namespace storage
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Map storage based on a hash table with chained buckets.
+/*!
+ * Map storage based on a hash table with chained buckets (singly-linked lists of nodes).
+ *
+ * Lookups (Get, Contains, ForEach) are lock-free and may be called concurrently with anything.
+ * Modifications (Insert, Set, Remove) acquire the mutex of the key's lock stripe only (lock striping with
+ * mutexes of type TMutex - the stripe is selected by the lower bits of the key's hash).
+ * So modifications of keys in different stripes do not block each other.
+ * Nodes are linked and unlinked so that concurrent readers always see consistent bucket lists.
+ * Removed nodes are deleted when no lookup can access them anymore (see tGracePeriods).
+ *
+ * When the number of entries exceeds the load limit, a table with twice the number of buckets is created.
+ * Entries are migrated to the new table incrementally: each modification migrates a few buckets
+ * (including the bucket of the key it modifies). Meanwhile, lookups check both tables.
+ * So no call ever needs to wait for a complete rehash.
+ * Only starting a resize and these migration steps acquire the map's mutex (and then the stripe mutex of each migrated bucket).
+ * Clear() clears one stripe after the other - entries added concurrently might remain in the map.
+ *
+ * \tparam INITIAL_BUCKET_COUNT Number of buckets in initial table (must be a power of two)
+ * \tparam MAX_LOAD_FACTOR_PERCENT Table is grown when number of entries exceeds this percentage of the number of buckets
+ * \tparam THash Hash function template (instantiated with the map's key type)
+ */
+template <size_t INITIAL_BUCKET_COUNT = 16, size_t MAX_LOAD_FACTOR_PERCENT = 100, template <typename> class THash = std::hash>
+struct HashTable
+{
+  static_assert(INITIAL_BUCKET_COUNT > 0 && (INITIAL_BUCKET_COUNT & (INITIAL_BUCKET_COUNT - 1)) == 0, "INITIAL_BUCKET_COUNT must be a power of two");
+  static_assert(MAX_LOAD_FACTOR_PERCENT > 0, "MAX_LOAD_FACTOR_PERCENT must be positive");
+
+  /*! Helper struct to select lock type for mutex */
+  template <typename TMutex, typename TDummy = void>
+  struct LockSelector
+  {
+    typedef rrlib::thread::tLock tLock;
+  };
+
+  template <typename TDummy>
+  struct LockSelector<tAdaptiveMutex, TDummy>
+  {
+    typedef tAdaptiveMutex::tLock tLock;
+  };
+
+  template <typename TKey, typename TValue, typename TMutex, typename TNullElement>
+  class tInstance : public TMutex
+  {
+    typedef typename LockSelector<TMutex>::tLock tMutexLock;
+
+    /*! Number of buckets migrated to a new table with every modification */
+    enum { cMIGRATION_STEP = 4 };
+
+    /*!
+     * Number of lock stripes. The stripe of a key is determined by the lower bits of its hash.
+     * As there are no more stripes than buckets, all nodes in a bucket belong to the same stripe - in any table.
+     */
+    enum { cLOCK_STRIPES = INITIAL_BUCKET_COUNT < 32 ? INITIAL_BUCKET_COUNT : 32 };
+
+    enum { cCACHE_LINE_SIZE = 64 };
+
+    struct tNode;
+    struct tTable;
+
+    //----------------------------------------------------------------------
+    // Public methods and typedefs
+    //----------------------------------------------------------------------
+  public:
+
+    tInstance() :
+      current_table(new tTable(INITIAL_BUCKET_COUNT)),
+      size(0)
+    {}
+
+    tInstance(const tInstance&) = delete;
+    tInstance& operator=(const tInstance&) = delete;
+
+    ~tInstance()
+    {
+      tTable* table = current_table.load();
+      DeleteTable(table->previous.load());
+      DeleteTable(table);
+    }
+
+    void Clear()
+    {
+      tGracePeriods::tReadSection read_section(grace_periods);
+      tMutexLock lock(*this);
+      tTable* table = current_table.load();
+      while (table->previous.load())
+      {
+        MigrateBuckets(table, cMIGRATION_STEP);
+      }
+      for (size_t i = 0; i < cLOCK_STRIPES; i++)
+      {
+        tStripe& stripe = stripes[i];
+        tMutexLock stripe_lock(stripe.mutex);
+        for (size_t bucket = i; bucket < table->bucket_count; bucket += cLOCK_STRIPES)
+        {
+          tNode* node = table->buckets[bucket].exchange(NULL);
+          while (node)
+          {
+            tNode* next = node->next.load();
+            size--;
+            stripe.retired_nodes.Retire(node, grace_periods);
+            node = next;
+          }
+        }
+      }
+    }
+
+    bool Contains(const TKey& key) const
+    {
+      return Get(key) != TNullElement::cNULL_ELEMENT;
+    }
+
+    bool Empty() const
+    {
+      return size.load() == 0;
+    }
+
+    template <typename TFunction>
+    void ForEach(TFunction function) const
+    {
+      tGracePeriods::tReadSection read_section(grace_periods);
+      tTable* table = current_table.load();
+      tTable* previous = table->previous.load();
+      if (!previous)
+      {
+        for (size_t i = 0; i < table->bucket_count; i++)
+        {
+          ForEachInBucket(table->buckets[i], function);
+        }
+        return;
+      }
+
+      // Entries of old bucket i are migrated to new buckets i and (i + previous->bucket_count)
+      for (size_t i = 0; i < previous->bucket_count; i++)
+      {
+        if (previous->migrated[i].load())
+        {
+          ForEachInBucket(table->buckets[i], function);
+          ForEachInBucket(table->buckets[i + previous->bucket_count], function);
+        }
+        else
+        {
+          ForEachInBucket(previous->buckets[i], function);
+        }
+      }
+    }
+
+    TValue Get(const TKey& key) const
+    {
+      tGracePeriods::tReadSection read_section(grace_periods);
+      size_t hash = hasher(key);
+      while (true)
+      {
+        tTable* table = current_table.load();
+        tTable* previous = table->previous.load();
+        if (previous)
+        {
+          // Value in previous table is valid if bucket was not migrated before value was loaded
+          size_t bucket = hash & (previous->bucket_count - 1);
+          if (!previous->migrated[bucket].load())
+          {
+            TValue value = LoadValue(FindNode(*previous, hash, key));
+            if (!previous->migrated[bucket].load())
+            {
+              return value;
+            }
+          }
+        }
+
+        // Value in current table is valid if table was not replaced before value was loaded
+        TValue value = LoadValue(FindNode(*table, hash, key));
+        if (current_table.load() == table)
+        {
+          return value;
+        }
+      }
+    }
+
+    bool Insert(const TKey& key, const TValue& value)
+    {
+      tGracePeriods::tReadSection read_section(grace_periods);
+      size_t hash = hasher(key);
+      PrepareModification();
+      tMutexLock lock(GetStripe(hash).mutex);
+      tTable& table = GetTableForModification(hash);
+      if (FindNode(table, hash, key))
+      {
+        return false;
+      }
+      AddNode(table, new tNode(key, hash, value));
+      return true;
+    }
+
+    TValue Remove(const TKey& key)
+    {
+      tGracePeriods::tReadSection read_section(grace_periods);
+      size_t hash = hasher(key);
+      PrepareModification();
+      tStripe& stripe = GetStripe(hash);
+      tMutexLock lock(stripe.mutex);
+      tTable& table = GetTableForModification(hash);
+      std::atomic<tNode*>* link = &table.buckets[hash & (table.bucket_count - 1)];
+      for (tNode* node = link->load(); node; node = link->load())
+      {
+        if (node->hash == hash && node->key == key)
+        {
+          TValue value = node->value.load();
+          link->store(node->next.load());
+          size--;
+          stripe.retired_nodes.Retire(node, grace_periods);
+          return value;
+        }
+        link = &node->next;
+      }
+      return TNullElement::cNULL_ELEMENT;
+    }
+
+    TValue Set(const TKey& key, const TValue& value)
+    {
+      tGracePeriods::tReadSection read_section(grace_periods);
+      size_t hash = hasher(key);
+      PrepareModification();
+      tMutexLock lock(GetStripe(hash).mutex);
+      tTable& table = GetTableForModification(hash);
+      tNode* node = FindNode(table, hash, key);
+      if (node)
+      {
+        return node->value.exchange(value);
+      }
+      AddNode(table, new tNode(key, hash, value));
+      return TNullElement::cNULL_ELEMENT;
+    }
+
+    size_t Size() const
+    {
+      return size.load();
+    }
+
+    //----------------------------------------------------------------------
+    // Private fields and methods
+    //----------------------------------------------------------------------
+  private:
+
+    /*! Map entry */
+    struct tNode
+    {
+      tNode(const TKey& key, size_t hash, const TValue& value) :
+        key(key),
+        hash(hash),
+        value(value),
+        next(NULL)
+      {}
+
+      /*! Key of entry */
+      const TKey key;
+
+      /*! Hash of key */
+      const size_t hash;
+
+      /*! Value of entry */
+      std::atomic<TValue> value;
+
+      /*! Next node in bucket */
+      std::atomic<tNode*> next;
+    };
+
+    /*! Hash table */
+    struct tTable
+    {
+      explicit tTable(size_t bucket_count) :
+        bucket_count(bucket_count),
+        buckets(new std::atomic<tNode*>[bucket_count]()),
+        migrated(new std::atomic<bool>[bucket_count]()),
+        migrated_count(0),
+        migration_cursor(0),
+        previous(NULL)
+      {}
+
+      /*! Number of buckets (power of two) */
+      const size_t bucket_count;
+
+      /*! Buckets: each points to first node in bucket */
+      std::unique_ptr<std::atomic<tNode*>[]> buckets;
+
+      /*! Which buckets have been migrated to a new table (only used while entries are migrated) */
+      std::unique_ptr<std::atomic<bool>[]> migrated;
+
+      /*! Number of migrated buckets (buckets are migrated with their stripe's mutex acquired) */
+      std::atomic<size_t> migrated_count;
+
+      /*! Next bucket to migrate in regular migration steps (written with map's mutex acquired only) */
+      size_t migration_cursor;
+
+      /*! Previous table whose entries are being migrated to this one (NULL when migration is complete) */
+      std::atomic<tTable*> previous;
+    };
+
+    /*!
+     * Objects retired by holders of one mutex - for even and odd epochs.
+     * The objects in a list are deleted when no lookup can access them anymore:
+     * two epochs after the last object was added to the list.
+     */
+    template <typename TObject>
+    class tRetiredObjects
+    {
+    public:
+
+      tRetiredObjects() : epochs() {}
+
+      ~tRetiredObjects()
+      {
+        for (size_t i = 0; i < 2; i++)
+        {
+          DeleteObjects(i);
+        }
+      }
+
+      /*!
+       * Retires object (with mutex acquired) - and deletes retired objects that no lookup can access anymore
+       *
+       * \param object Object to retire (must already be unlinked)
+       * \param grace_periods Grace periods of map
+       */
+      void Retire(TObject* object, tGracePeriods& grace_periods)
+      {
+        size_t epoch = grace_periods.GetEpoch();
+        objects[epoch & 1].push_back(object);
+        epochs[epoch & 1] = epoch;
+        grace_periods.TryAdvance();
+        epoch = grace_periods.GetEpoch();
+        for (size_t i = 0; i < 2; i++)
+        {
+          if (epoch >= epochs[i] + 2)
+          {
+            DeleteObjects(i);
+          }
+        }
+      }
+
+    private:
+
+      /*! Retired objects - for even and odd epochs */
+      std::vector<TObject*> objects[2];
+
+      /*! Epoch in which the last object was added to each list */
+      size_t epochs[2];
+
+      void DeleteObjects(size_t index)
+      {
+        for (auto it = objects[index].begin(); it != objects[index].end(); ++it)
+        {
+          tInstance::DeleteObject(*it);
+        }
+        objects[index].clear();
+      }
+    };
+
+    /*!
+     * Lock stripe.
+     * Its mutex protects the buckets of the stripe's keys in all tables (including migration of these buckets).
+     */
+    struct tStripe
+    {
+      /*! Mutex for modifying the stripe's buckets */
+      TMutex mutex;
+
+      /*! Nodes removed from the stripe's buckets (with mutex acquired) */
+      tRetiredObjects<tNode> retired_nodes;
+
+      /*! Keeps stripes in separate cache lines */
+      char padding[cCACHE_LINE_SIZE];
+    };
+
+    /*! Current table */
+    std::atomic<tTable*> current_table;
+
+    /*! Number of entries in map */
+    std::atomic<size_t> size;
+
+    /*! Grace periods - lookups and modifications are read sections */
+    tGracePeriods grace_periods;
+
+    /*! Lock stripes */
+    std::array<tStripe, cLOCK_STRIPES> stripes;
+
+    /*! Retired tables (with map's mutex acquired) */
+    tRetiredObjects<tTable> retired_tables;
+
+    /*! Hash function */
+    THash<TKey> hasher;
+
+
+    /*!
+     * Adds node to front of its bucket in table (with stripe's mutex acquired)
+     */
+    void AddNode(tTable& table, tNode* node)
+    {
+      std::atomic<tNode*>& bucket = table.buckets[node->hash & (table.bucket_count - 1)];
+      node->next.store(bucket.load(), std::memory_order_relaxed);
+      bucket.store(node);
+      size++;
+    }
+
+    /*!
+     * Deletes retired node or table
+     */
+    static void DeleteObject(tNode* node)
+    {
+      delete node;
+    }
+    static void DeleteObject(tTable* table)
+    {
+      DeleteTable(table);
+    }
+
+    /*!
+     * Deletes table and all nodes in it
+     */
+    static void DeleteTable(tTable* table)
+    {
+      if (!table)
+      {
+        return;
+      }
+      for (size_t i = 0; i < table->bucket_count; i++)
+      {
+        tNode* node = table->buckets[i].load();
+        while (node)
+        {
+          tNode* next = node->next.load();
+          delete node;
+          node = next;
+        }
+      }
+      delete table;
+    }
+
+    /*!
+     * \return Node with specified key in table (NULL if there is none)
+     */
+    static tNode* FindNode(tTable& table, size_t hash, const TKey& key)
+    {
+      for (tNode* node = table.buckets[hash & (table.bucket_count - 1)].load(); node; node = node->next.load())
+      {
+        if (node->hash == hash && node->key == key)
+        {
+          return node;
+        }
+      }
+      return NULL;
+    }
+
+    template <typename TFunction>
+    static void ForEachInBucket(const std::atomic<tNode*>& bucket, TFunction& function)
+    {
+      for (tNode* node = bucket.load(); node; node = node->next.load())
+      {
+        function(node->key, node->value.load());
+      }
+    }
+
+    /*!
+     * \param hash Hash of key (or index of bucket in any table)
+     * \return Lock stripe of key
+     */
+    tStripe& GetStripe(size_t hash)
+    {
+      return stripes[hash & (cLOCK_STRIPES - 1)];
+    }
+
+    /*!
+     * Returns table in which entry may be modified (with stripe's mutex acquired).
+     * While entries are migrated, the key's bucket is migrated first.
+     *
+     * \param hash Hash of key to modify
+     * \return Current table
+     */
+    tTable& GetTableForModification(size_t hash)
+    {
+      tTable* table = current_table.load();
+      tTable* previous = table->previous.load();
+      if (previous)
+      {
+        MigrateBucket(*table, *previous, hash & (previous->bucket_count - 1));
+      }
+      return *table;
+    }
+
+    static TValue LoadValue(tNode* node)
+    {
+      return node ? node->value.load() : static_cast<TValue>(TNullElement::cNULL_ELEMENT);
+    }
+
+    /*!
+     * Migrates buckets from previous table to new table (with map's mutex acquired - and no stripe's mutex).
+     * Nodes are copied - so that lookups traversing the previous table are not affected.
+     * When all buckets have been migrated, the previous table is retired.
+     *
+     * \param table Current table
+     * \param count Number of buckets to migrate
+     */
+    void MigrateBuckets(tTable* table, size_t count)
+    {
+      tTable* previous = table->previous.load();
+      for (size_t i = 0; i < count && previous->migration_cursor < previous->bucket_count; i++)
+      {
+        tMutexLock stripe_lock(GetStripe(previous->migration_cursor).mutex);
+        MigrateBucket(*table, *previous, previous->migration_cursor);
+        previous->migration_cursor++;
+      }
+      if (previous->migrated_count.load() == previous->bucket_count)
+      {
+        table->previous.store(NULL);
+        retired_tables.Retire(previous, grace_periods);
+      }
+    }
+
+    /*!
+     * Migrates single bucket from previous table to new table (with bucket's stripe mutex acquired).
+     * As the new table has twice as many buckets, the nodes are moved to buckets of the same stripe.
+     */
+    void MigrateBucket(tTable& table, tTable& previous, size_t bucket)
+    {
+      if (previous.migrated[bucket].load(std::memory_order_relaxed))
+      {
+        return;
+      }
+      for (tNode* node = previous.buckets[bucket].load(); node; node = node->next.load())
+      {
+        std::atomic<tNode*>& target = table.buckets[node->hash & (table.bucket_count - 1)];
+        tNode* copy = new tNode(node->key, node->hash, node->value.load());
+        copy->next.store(target.load(), std::memory_order_relaxed);
+        target.store(copy);
+      }
+      previous.migrated[bucket].store(true);
+      previous.migrated_count++;
+    }
+
+    /*!
+     * Prepares modification (with no mutex acquired):
+     * Grows table if required and performs a migration step while entries are migrated.
+     * Only then, the map's mutex is acquired.
+     */
+    void PrepareModification()
+    {
+      tTable* table = current_table.load();
+      if ((!table->previous.load()) && (size.load() + 1) * 100 <= table->bucket_count * MAX_LOAD_FACTOR_PERCENT)
+      {
+        return;
+      }
+      tMutexLock lock(*this);
+      table = current_table.load();
+      if (!table->previous.load())
+      {
+        if ((size.load() + 1) * 100 <= table->bucket_count * MAX_LOAD_FACTOR_PERCENT)
+        {
+          return;  // another thread has grown table
+        }
+        tTable* new_table = new tTable(table->bucket_count * 2);
+        new_table->previous.store(table);
+        current_table.store(new_table);
+        table = new_table;
+      }
+      MigrateBuckets(table, cMIGRATION_STEP);
+    }
+  };
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+}
+
+
+#endif
@@ -44,11 +44,20 @@
 //----------------------------------------------------------------------
 #include <atomic>
 #include <array>
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <cassert>
+#include <type_traits>
+#include <cstdint>
 #include "rrlib/thread/tLock.h"
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tGracePeriods.h"
+#include "rrlib/concurrent_containers/tAdaptiveMutex.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -76,19 +85,30 @@ namespace storage
  *  Whenever the capacity is insufficient, another array chunk is appended.
  * This policy is quite efficient with respect to memory footprint,
  * if set size does not exceed the initial size often.
+ * With CHUNK_SIZE_INCREASE_FACTOR > 1, the number of chunks grows only logarithmically with the set size.
+ *
+ * If T is a unique_ptr type, the set owns its elements and stores raw pointers internally.
+ * Removed elements are not deleted immediately, but only after all iterators that might
+ * still point to them have been destructed (see tGracePeriods).
  *
  * \tparam INITIAL_CHUNK_SIZE Entries/slots in initial chunk
- * \tparam FURTHER_CHUNKS_SIZE Entries/slots in any further appended chunks
- * \tparam CHUNK_SIZE_INCREASE_FACTOR Second appended chunk will have a size of SECOND_CHUNKS_SIZE * CHUNK_SIZE_INCREASE_FACTOR.
- *                                    The third chunk's size will be increased by this factor again.
+ * \tparam FURTHER_CHUNKS_SIZE Entries/slots in first appended chunk (and in any further appended chunks with CHUNK_SIZE_INCREASE_FACTOR 1)
  * \tparam SINGLE_THREADED Is tSet in a single-threaded context only?
  *                         Setting this, the set is actually no longer suitable for concurrency.
  *                         However, this option is provided so that tSet can conveniently
  *                         be used in templates that might sometimes be used a single-threaded context.
+ * \tparam TAllocator Allocator for further chunks (rebound to chunk type - e.g. a pool or arena allocator).
+ *                    Together with Reserve(), chunks can be allocated in advance - so that adding elements
+ *                    does not allocate memory (e.g. in real-time threads).
+ * \tparam CHUNK_SIZE_INCREASE_FACTOR Second appended chunk will have a size of FURTHER_CHUNKS_SIZE * CHUNK_SIZE_INCREASE_FACTOR.
+ *                                    The third chunk's size will be increased by this factor again - and so on.
+ * \tparam CHANGE_LOG_SIZE Number of entries in log of recent changes (see tSet::IterateChangesSince()). 0 disables change tracking.
  */
-template <size_t INITIAL_CHUNK_SIZE, size_t FURTHER_CHUNKS_SIZE, bool SINGLE_THREADED = false>
+template < size_t INITIAL_CHUNK_SIZE, size_t FURTHER_CHUNKS_SIZE, bool SINGLE_THREADED = false, typename TAllocator = std::allocator<char>,
+         size_t CHUNK_SIZE_INCREASE_FACTOR = 1, size_t CHANGE_LOG_SIZE = 0 >
 struct ArrayChunkBased
 {
+  static_assert(FURTHER_CHUNKS_SIZE > 0 && CHUNK_SIZE_INCREASE_FACTOR > 0, "Further chunks must have at least one slot");
 
   /*! Helper struct to realize optional iterator dereferencing */
   template <typename T, bool DEREFERENCE>
@@ -103,17 +123,225 @@ struct ArrayChunkBased
     typedef typename std::remove_pointer<T>::type tReturnType;
   };
 
+  /*! Helper struct to select lock type for mutex type (rrlib::thread::tLock - or the mutex's own lock type) */
+  template <typename TMutex, typename TDummy = void>
+  struct LockSelector
+  {
+    typedef rrlib::thread::tLock tLock;
+  };
+
+  template <typename TDummy>
+  struct LockSelector<tAdaptiveMutex, TDummy>
+  {
+    typedef tAdaptiveMutex::tLock tLock;
+  };
+
+  /*!
+   * Helper class for deletion of removed elements in sets that own their elements.
+   * Sets that do not own their elements (the default) do not delete anything.
+   */
+  template <typename T>
+  class tElementDeleter
+  {
+  public:
+
+    /*! Type of elements stored in set */
+    typedef T tElement;
+
+    enum { cOWNING = false };
+
+    /*! Read section - no-op */
+    struct tReadSection
+    {
+      tReadSection() {}
+      explicit tReadSection(const tElementDeleter&) {}
+    };
+
+    void Delete(const T&) {}
+    void Retire(const T&) {}
+  };
+
+  /*!
+   * Sets of unique pointers own their elements.
+   * Removed elements are retired and deleted when the next grace period has passed
+   * (when all iterators that were created before the removal have been destructed).
+   */
+  template <typename U, typename D>
+  class tElementDeleter<std::unique_ptr<U, D>>
+  {
+  public:
+
+    /*! Type of elements stored in set */
+    typedef U* tElement;
+
+    enum { cOWNING = true };
+
+    /*! Read section - iterators are read sections so that elements they might point to are not deleted */
+    struct tReadSection : tGracePeriods::tReadSection
+    {
+      tReadSection() {}
+      explicit tReadSection(const tElementDeleter& deleter) : tGracePeriods::tReadSection(deleter.grace_periods) {}
+    };
+
+    ~tElementDeleter()
+    {
+      for (size_t i = 0; i < 2; i++)
+      {
+        for (auto it = retired[i].begin(); it != retired[i].end(); ++it)
+        {
+          Delete(*it);
+        }
+      }
+    }
+
+    /*!
+     * Deletes element immediately
+     * (may only be called if no iterator can point to element)
+     */
+    void Delete(U* element)
+    {
+      D()(element);
+    }
+
+    /*!
+     * Retires element that was removed from set.
+     * It is deleted as soon as no iterator can point to it anymore.
+     * Must be called with set's mutex acquired.
+     *
+     * \param element Element to retire
+     */
+    void Retire(U* element)
+    {
+      retired[grace_periods.GetEpoch() & 1].push_back(element);
+      if (grace_periods.TryAdvance())
+      {
+        std::vector<U*>& deletable = retired[grace_periods.GetEpoch() & 1];
+        for (auto it = deletable.begin(); it != deletable.end(); ++it)
+        {
+          Delete(*it);
+        }
+        deletable.clear();
+      }
+    }
+
+  private:
+
+    /*! Grace periods - iterators are read sections */
+    tGracePeriods grace_periods;
+
+    /*! Retired elements - for even and odd epochs */
+    std::vector<U*> retired[2];
+  };
+
+  /*!
+   * Bounded log of recent changes (ring buffer).
+   * Written with set's mutex acquired. Readers need to check for concurrent modifications (seqlock).
+   */
+  template <typename TElement, size_t SIZE>
+  class tChangeLog
+  {
+  public:
+
+    tChangeLog() : entries_written(0), overwritten_version(0) {}
+
+    /*!
+     * Collects changes in log
+     *
+     * \param version Version to collect changes since
+     * \param changes Array to store changes in (element and whether it was added), oldest first
+     * \param change_count Contains number of collected changes after call
+     * \return False if log does not contain all changes since version (as entries have been overwritten)
+     */
+    bool CollectChangesSince(size_t version, std::array<std::pair<TElement, bool>, SIZE>& changes, size_t& change_count) const
+    {
+      change_count = 0;
+      if (overwritten_version.load() > version)
+      {
+        return false;
+      }
+      size_t written = entries_written.load();
+      size_t first = written;
+      while (first > 0 && first + SIZE > written && entries[(first - 1) % SIZE].version.load() > version)
+      {
+        first--;
+      }
+      for (size_t i = first; i < written; i++)
+      {
+        const tEntry& entry = entries[i % SIZE];
+        changes[change_count++] = std::pair<TElement, bool>(entry.element.load(), entry.added.load());
+      }
+      return true;
+    }
+
+    /*!
+     * Logs change
+     *
+     * \param version Version of set after change
+     * \param element Element that was added or removed
+     * \param added True if element was added - false if it was removed
+     */
+    void LogChange(size_t version, TElement element, bool added)
+    {
+      size_t written = entries_written.load(std::memory_order_relaxed);
+      tEntry& entry = entries[written % SIZE];
+      if (written >= SIZE)
+      {
+        overwritten_version = entry.version.load(std::memory_order_relaxed);
+      }
+      entry.version = version;
+      entry.element = element;
+      entry.added = added;
+      entries_written = written + 1;
+    }
+
+  private:
+
+    struct tEntry
+    {
+      std::atomic<size_t> version;
+      std::atomic<TElement> element;
+      std::atomic<bool> added;
+    };
+
+    /*! Entries in ring buffer */
+    std::array<tEntry, SIZE> entries;
+
+    /*! Number of entries written to log */
+    std::atomic<size_t> entries_written;
+
+    /*! Version of last overwritten entry */
+    std::atomic<size_t> overwritten_version;
+  };
+
+  /*! Without change log, changes are not logged */
+  template <typename TElement>
+  class tChangeLog<TElement, 0>
+  {
+  public:
+    void LogChange(size_t, TElement, bool) {}
+  };
+
   template <typename T, tAllowDuplicates ALLOW_DUPLICATES, typename TMutex, typename TNullElement, bool DEREFERENCING_ITERATOR>
-  class tInstance : public TMutex
+  class tInstance : public TMutex, private tElementDeleter<T>, private TAllocator, private tChangeLog<typename tElementDeleter<T>::tElement, CHANGE_LOG_SIZE>
   {
+    typedef tElementDeleter<T> tDeleter;
+    typedef tChangeLog<typename tElementDeleter<T>::tElement, CHANGE_LOG_SIZE> tChangeLogBase;
+    typedef typename LockSelector<TMutex>::tLock tMutexLock;
     /*! The set storage is a linked list of array chunks */
     template <size_t SIZE>
     struct tArrayChunk;
 
     typedef tArrayChunk<INITIAL_CHUNK_SIZE> tFirstChunk;
-    typedef tArrayChunk<FURTHER_CHUNKS_SIZE> tFurtherChunk;
+    typedef typename std::conditional<SINGLE_THREADED, typename tDeleter::tElement, std::atomic<typename tDeleter::tElement>>::type tArrayElement;
+
+    /*!
+     * Further chunks have sizes that are only known at runtime (with CHUNK_SIZE_INCREASE_FACTOR > 1).
+     * Their memory layout is the same as tArrayChunk's: array elements, followed by the pointer to the next chunk,
+     * followed by the slot generations.
+     * They are referenced by a pointer to their first element.
+     */
+    typedef tArrayElement tFurtherChunk;
     typedef typename std::conditional<SINGLE_THREADED, tFurtherChunk*, std::atomic<tFurtherChunk*>>::type tFurtherChunkPointer;
-    typedef typename std::conditional<SINGLE_THREADED, T, std::atomic<T>>::type tArrayElement;
     typedef typename std::conditional<SINGLE_THREADED, size_t, std::atomic<size_t>>::type tSize;
 
     template <size_t SIZE>
@@ -125,41 +353,106 @@ struct ArrayChunkBased
       /*! Pointer to next chunk -> linked-list */
       tFurtherChunkPointer next_chunk;
 
+      /*! Generations of slots - in reverse order (see SlotGeneration()) */
+      std::array<uint32_t, SIZE> generations;
+
       static_assert(sizeof(buffers) % sizeof(next_chunk) == 0, "Please choose a chunk size that does not waste memory");
 
-      ~tArrayChunk()
-      {
-        tFurtherChunk* next = next_chunk;
-        delete next;
-      }
+      tArrayChunk() : next_chunk(NULL), generations() {}
     };
 
+    static_assert((FURTHER_CHUNKS_SIZE * sizeof(tArrayElement)) % sizeof(tFurtherChunkPointer) == 0, "Please choose a chunk size that does not waste memory");
+
+    /*! Further chunks are allocated in units of this type */
+    typedef typename std::aligned_storage < (sizeof(tArrayElement) < sizeof(tFurtherChunkPointer) ? sizeof(tArrayElement) : sizeof(tFurtherChunkPointer)),
+            (alignof(tArrayElement) > alignof(tFurtherChunkPointer) ? alignof(tArrayElement) : alignof(tFurtherChunkPointer)) >::type tChunkUnit;
+    typedef typename std::allocator_traits<TAllocator>::template rebind_alloc<tChunkUnit> tChunkAllocator;
+
     //----------------------------------------------------------------------
     // Public methods and typedefs
     //----------------------------------------------------------------------
   public:
 
+    /*! Type of elements stored in set (T - or raw pointer for sets of unique pointers) */
+    typedef typename tDeleter::tElement tElement;
+
     // Iterator types
     class tConstIterator;
 
-    tInstance() : size(0) {}
+    /*! Handle to element in set (slot in chunk, its index, and slot generation when element was added) */
+    class tHandle
+    {
+    public:
+      tHandle() : slot(NULL), slot_generation(NULL), index(0), generation(0) {}
+
+    private:
+      friend class tInstance;
+
+      tHandle(tArrayElement* slot, uint32_t& slot_generation, size_t index) : slot(slot), slot_generation(&slot_generation), index(index), generation(slot_generation) {}
+
+      /*! Slot that element was added to (NULL for invalid handle) */
+      tArrayElement* slot;
+
+      /*! Current generation of slot */
+      uint32_t* slot_generation;
+
+      /*! Index of slot in set */
+      size_t index;
+
+      /*! Generation of slot while element is in it */
+      uint32_t generation;
+    };
+
+    tInstance() : size(0), reserved(false), modification_counter(0)
+    {
+      assert((INITIAL_CHUNK_SIZE == 0 || (void*)(&first_chunk.next_chunk + 1) == (void*)first_chunk.generations.data()) && "Slot generations must follow pointer to next chunk");
+    }
+
+    ~tInstance()
+    {
+      if (tDeleter::cOWNING)
+      {
+        for (auto it = tIteratorInternal<false>(*this); it != tIteratorInternal<false>(); ++it)
+        {
+          if (it.current_element != TNullElement::cNULL_ELEMENT)
+          {
+            this->Delete(it.current_element);
+          }
+        }
+      }
+
+      tFurtherChunk* chunk = first_chunk.next_chunk;
+      size_t chunk_capacity = FURTHER_CHUNKS_SIZE;
+      while (chunk)
+      {
+        tFurtherChunk* next = *NextChunkPointer(chunk, chunk_capacity);
+        DeallocateChunk(chunk, chunk_capacity);
+        chunk = next;
+        chunk_capacity *= CHUNK_SIZE_INCREASE_FACTOR;
+      }
+    }
 
-    void Add(const T& element)
+    tHandle Add(const tElement& element)
     {
-      rrlib::thread::tLock lock(*this);
+      tMutexLock lock(*this);
 
       // Check for duplicates
       tArrayElement* first_free = NULL;
+      uint32_t* first_free_generation = NULL;
+      size_t first_free_index = 0;
+      size_t index = 0;
       tIteratorInternal<false> it(*this);
-      for (; it != tIteratorInternal<false>(); ++it)
+      for (; it != tIteratorInternal<false>(); ++it, ++index)
       {
         if (ALLOW_DUPLICATES == tAllowDuplicates::NO && it.current_element == element)
         {
-          return;
+          return tHandle(it.current_array_entry, it.CurrentSlotGeneration(), index);
         }
         else if ((!first_free) && it.current_element == TNullElement::cNULL_ELEMENT)
         {
           first_free = it.current_array_entry;
+          first_free_generation = &it.CurrentSlotGeneration();
+          first_free_index = index;
           if (ALLOW_DUPLICATES != tAllowDuplicates::NO)
           {
             break;
@@ -168,24 +461,90 @@ struct ArrayChunkBased
       }
 
       // insert
+      tModification modification(*this);
+      modification.Begin();
+      modification.LogChange(element, true);
       if (first_free)
       {
         (*first_free) = element;
-        //size += 0; // TODO:
+        MarkSlotUsed(*first_free_generation);
+        return tHandle(first_free, *first_free_generation, first_free_index);
       }
-      else
+      size_t append_index = size;
+      Append(element, it);
+      return tHandle(it.past_last_array_entry - 1, SlotGeneration(it.past_last_array_entry - 1, it.next_chunk), append_index);
+    }
+
+    template <typename TIterator>
+    void AddRange(TIterator begin, TIterator end)
+    {
+      // Sort batch for efficient duplicate detection
+      std::vector<tElement> batch;
+      for (; begin != end; ++begin)
       {
-        if ((void*)it.past_last_array_entry != (void*)it.next_chunk)
+        if (*begin != TNullElement::cNULL_ELEMENT)
         {
-          *it.past_last_array_entry = element;
+          batch.push_back(*begin);
+        }
+      }
+      std::vector<tElement> sorted_batch(batch);
+      if (ALLOW_DUPLICATES == tAllowDuplicates::NO)
+      {
+        std::sort(sorted_batch.begin(), sorted_batch.end());
+        sorted_batch.erase(std::unique(sorted_batch.begin(), sorted_batch.end()), sorted_batch.end());
+      }
+      std::vector<bool> in_set(sorted_batch.size(), false);
+
+      tMutexLock lock(*this);
+
+      // Single pass: look for elements that are already in set and collect free slots
+      std::vector<std::pair<tArrayElement*, uint32_t*>> free_slots;
+      tIteratorInternal<false> it(*this);
+      for (; it != tIteratorInternal<false>(); ++it)
+      {
+        if (it.current_element == TNullElement::cNULL_ELEMENT)
+        {
+          if (free_slots.size() < batch.size())
+          {
+            free_slots.push_back(std::make_pair(it.current_array_entry, &it.CurrentSlotGeneration()));
+          }
+        }
+        else if (ALLOW_DUPLICATES == tAllowDuplicates::NO)
+        {
+          auto sorted_position = std::lower_bound(sorted_batch.begin(), sorted_batch.end(), it.current_element);
+          if (sorted_position != sorted_batch.end() && *sorted_position == it.current_element)
+          {
+            in_set[sorted_position - sorted_batch.begin()] = true;
+          }
+        }
+      }
+
+      // Fill free slots in order - then append remaining elements
+      tModification modification(*this);
+      auto free_slot = free_slots.begin();
+      for (auto element = batch.begin(); element != batch.end(); ++element)
+      {
+        if (ALLOW_DUPLICATES == tAllowDuplicates::NO)
+        {
+          size_t index = std::lower_bound(sorted_batch.begin(), sorted_batch.end(), *element) - sorted_batch.begin();
+          if (in_set[index])
+          {
+            continue;
+          }
+          in_set[index] = true;
+        }
+        modification.Begin();
+        modification.LogChange(*element, true);
+        if (free_slot != free_slots.end())
+        {
+          (*free_slot->first) = *element;
+          MarkSlotUsed(*free_slot->second);
+          ++free_slot;
         }
         else
         {
-          tFurtherChunk* new_chunk = new tFurtherChunk();
-          *it.next_chunk = new_chunk;
-          new_chunk->buffers[0] = element;
+          Append(*element, it);
         }
-        size++; // important: do this last
       }
     }
 
@@ -194,13 +553,91 @@ struct ArrayChunkBased
       return tConstIterator(*this);
     }
 
+    bool Contains(const tElement& element) const
+    {
+      for (tIteratorInternal<true> it(*this); it != tIteratorInternal<true>(); ++it)
+      {
+        if (it.current_element == element)
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    size_t CopyTo(tElement* buffer, size_t capacity) const
+    {
+      size_t remaining_slots = size;
+      size_t count = 0;
+      const tArrayElement* chunk = first_chunk.buffers.data();
+      size_t chunk_capacity = INITIAL_CHUNK_SIZE;
+      size_t next_chunk_capacity = FURTHER_CHUNKS_SIZE;
+      while (true)
+      {
+        size_t slots = std::min(remaining_slots, chunk_capacity);
+        if (count + slots <= capacity)
+        {
+          // Fast path: compact elements into buffer without branches
+          for (size_t i = 0; i < slots; i++)
+          {
+            tElement element = LoadElement(chunk[i]);
+            buffer[count] = element;
+            count += (element != TNullElement::cNULL_ELEMENT) ? 1 : 0;
+          }
+        }
+        else
+        {
+          for (size_t i = 0; i < slots; i++)
+          {
+            tElement element = LoadElement(chunk[i]);
+            if (element != TNullElement::cNULL_ELEMENT)
+            {
+              if (count < capacity)
+              {
+                buffer[count] = element;
+              }
+              count++;
+            }
+          }
+        }
+        remaining_slots -= slots;
+        if (!remaining_slots)
+        {
+          return count;
+        }
+        chunk = *NextChunkPointer(chunk, chunk_capacity);
+        chunk_capacity = next_chunk_capacity;
+        next_chunk_capacity *= CHUNK_SIZE_INCREASE_FACTOR;
+      }
+    }
+
+    void Snapshot(std::vector<tElement>& snapshot) const
+    {
+      snapshot.resize(size);
+      size_t count = CopyTo(snapshot.data(), snapshot.size());
+      while (count > snapshot.size())  // elements were added concurrently
+      {
+        snapshot.resize(count);
+        count = CopyTo(snapshot.data(), snapshot.size());
+      }
+      snapshot.resize(count);
+    }
+
     void Clear()
     {
-      rrlib::thread::tLock lock(*this);
+      tMutexLock lock(*this);
+      tModification modification(*this);
+      modification.Begin();
       tIteratorInternal<false> it(*this);
       for (; it != tIteratorInternal<false>(); ++it)
       {
         (*it.current_array_entry) = TNullElement::cNULL_ELEMENT;
+        if (it.current_element != TNullElement::cNULL_ELEMENT)
+        {
+          modification.LogChange(it.current_element, false);
+          MarkSlotFree(it.CurrentSlotGeneration());
+          this->Retire(it.current_element);
+        }
       }
       size = 0;
     }
@@ -215,67 +652,195 @@ struct ArrayChunkBased
       return tConstIterator();
     }
 
+    std::vector<tConstIterator> Partition(size_t pieces) const
+    {
+      std::vector<tConstIterator> result;
+      size_t slots = size;
+      pieces = std::max<size_t>(1, std::min(pieces, slots));
+      size_t first_slot = 0;
+      for (size_t i = 0; i < pieces; i++)
+      {
+        size_t slot_count = (slots / pieces) + (i < (slots % pieces) ? 1 : 0);
+        result.push_back(tConstIterator(*this, first_slot, slot_count));
+        first_slot += slot_count;
+      }
+      return result;
+    }
+
     tConstIterator Remove(tConstIterator position)
     {
-      rrlib::thread::tLock lock(*this);
+      tMutexLock lock(*this);
+      tModification modification(*this);
       tArrayElement* current_array_entry = const_cast<tArrayElement*>(position.current_array_entry);
-      *(current_array_entry) = TNullElement::cNULL_ELEMENT;
+      if ((*current_array_entry) == position.current_element)  // element might have been removed concurrently
+      {
+        modification.Begin();
+        modification.LogChange(position.current_element, false);
+        *(current_array_entry) = TNullElement::cNULL_ELEMENT;
+        MarkSlotFree(SlotGeneration(current_array_entry, position.next_chunk));
+        this->Retire(position.current_element);
+      }
       ++position;
       if (position == End())
       {
-        // last element? Check, by how much we can decrease size  // TODO: optimize
-        size_t free_slots_at_back = 0;
-        for (auto it = tIteratorInternal<false>(*this); it != tIteratorInternal<false>(); ++it)
-        {
-          if ((*it) == TNullElement::cNULL_ELEMENT)
-          {
-            free_slots_at_back++;
-          }
-          else
-          {
-            free_slots_at_back = 0;
-          }
-        }
-        if (free_slots_at_back)
+        RemoveFreeSlotsAtBack(modification);
+      }
+      return position;
+    }
+
+    void Remove(const tHandle& handle)
+    {
+      if (!handle.slot)
+      {
+        return;
+      }
+      tMutexLock lock(*this);
+      tModification modification(*this);
+      if (handle.index < size && (*handle.slot_generation) == handle.generation)  // slot generation changes when element is removed
+      {
+        tElement element = LoadElement(*handle.slot);
+        modification.Begin();
+        modification.LogChange(element, false);
+        (*handle.slot) = TNullElement::cNULL_ELEMENT;
+        MarkSlotFree(*handle.slot_generation);
+        this->Retire(element);
+        if (handle.index + 1 == size)
         {
-          size -= free_slots_at_back;
+          RemoveFreeSlotsAtBack(modification);
         }
       }
-      return position;
     }
 
-    void Remove(const T& element)
+    void Remove(const tElement& element)
     {
-      rrlib::thread::tLock lock(*this);
+      RemoveIf([&element](const tElement & current_element)
+      {
+        return current_element == element;
+      });
+    }
+
+    template <typename TIterator>
+    void RemoveAll(TIterator begin, TIterator end)
+    {
+      std::vector<tElement> sorted_batch(begin, end);
+      std::sort(sorted_batch.begin(), sorted_batch.end());
+      RemoveIf([&sorted_batch](const tElement & current_element)
+      {
+        return std::binary_search(sorted_batch.begin(), sorted_batch.end(), current_element);
+      });
+    }
+
+    template <typename TPredicate>
+    void RemoveIf(TPredicate predicate)
+    {
+      tMutexLock lock(*this);
+      tModification modification(*this);
       tIteratorInternal<false> it(*this);
-      size_t free_slots_at_back = 0;
       for (; it != tIteratorInternal<false>(); ++it)
       {
-        if (it.current_element == element)
+        if (it.current_element != TNullElement::cNULL_ELEMENT && predicate(it.current_element))
         {
+          modification.Begin();
+          modification.LogChange(it.current_element, false);
           (*it.current_array_entry) = TNullElement::cNULL_ELEMENT;
-          free_slots_at_back++;
+          MarkSlotFree(it.CurrentSlotGeneration());
+          this->Retire(it.current_element);
+        }
+      }
+      RemoveFreeSlotsAtBack(modification);
+    }
+
+    void Reserve(size_t capacity)
+    {
+      tMutexLock lock(*this);
+      size_t current_capacity = INITIAL_CHUNK_SIZE;
+      size_t chunk_capacity = FURTHER_CHUNKS_SIZE;
+      tFurtherChunkPointer* link = &first_chunk.next_chunk;
+      while (current_capacity < capacity)
+      {
+        tFurtherChunk* chunk = *link;
+        if (!chunk)
+        {
+          chunk = AllocateChunk(chunk_capacity);
+          *link = chunk;
         }
-        else if (it.current_element == TNullElement::cNULL_ELEMENT)
+        current_capacity += chunk_capacity;
+        link = NextChunkPointer(chunk, chunk_capacity);
+        chunk_capacity *= CHUNK_SIZE_INCREASE_FACTOR;
+      }
+      reserved = true;
+    }
+
+    template <typename TFunction>
+    bool TryReadConsistent(TFunction function, size_t max_attempts) const
+    {
+      for (size_t attempt = 0; attempt < max_attempts; attempt++)
+      {
+        size_t counter_before = modification_counter;
+        if (counter_before & 1)
         {
-          free_slots_at_back++;
+          std::this_thread::yield();  // set is currently being modified
+          continue;
         }
-        else
+        function(Begin(), End());
+        if (modification_counter == counter_before)
         {
-          free_slots_at_back = 0;
+          return true;
         }
       }
-      if (free_slots_at_back)
+      return false;
+    }
+
+    bool TrySnapshot(std::vector<tElement>& snapshot, size_t max_attempts) const
+    {
+      return TryReadConsistent([&snapshot](tConstIterator begin, tConstIterator end)
+      {
+        snapshot.clear();
+        for (tConstIterator it = begin; it != end; ++it)
+        {
+          snapshot.push_back(it.current_element);
+        }
+      }, max_attempts);
+    }
+
+    size_t GetVersion() const
+    {
+      return modification_counter / 2;
+    }
+
+    template <typename TFunction>
+    tChangeIterationResult IterateChangesSince(size_t& version, TFunction function, size_t max_attempts) const
+    {
+      static_assert(CHANGE_LOG_SIZE > 0, "Change tracking requires a change log (set CHANGE_LOG_SIZE)");
+      std::array<std::pair<tElement, bool>, CHANGE_LOG_SIZE> changes;
+      size_t change_count = 0;
+      for (size_t attempt = 0; attempt < max_attempts; attempt++)
       {
-        size -= free_slots_at_back;
+        size_t counter_before = modification_counter;
+        if (counter_before & 1)
+        {
+          std::this_thread::yield();  // set is currently being modified
+          continue;
+        }
+        bool complete = this->CollectChangesSince(version, changes, change_count);
+        if (modification_counter == counter_before)
+        {
+          version = counter_before / 2;
+          for (size_t i = 0; i < change_count; i++)
+          {
+            function(changes[i].first, changes[i].second);
+          }
+          return complete ? tChangeIterationResult::COMPLETE : tChangeIterationResult::LOG_OVERFLOW;
+        }
       }
+      return tChangeIterationResult::INCONSISTENT;
     }
 
     /*! Iterator base implementation */
     template <bool CONST>
-    class tIteratorImplementation : public std::iterator<std::input_iterator_tag, typename IteratorCustomization<T, DEREFERENCING_ITERATOR>::tReturnType, size_t>
+    class tIteratorImplementation : public std::iterator<std::input_iterator_tag, typename IteratorCustomization<tElement, DEREFERENCING_ITERATOR>::tReturnType, size_t>
     {
-      typedef std::iterator<std::input_iterator_tag, typename IteratorCustomization<T, DEREFERENCING_ITERATOR>::tReturnType, size_t> tBase;
+      typedef std::iterator<std::input_iterator_tag, typename IteratorCustomization<tElement, DEREFERENCING_ITERATOR>::tReturnType, size_t> tBase;
 
     public:
 
@@ -308,7 +873,7 @@ struct ArrayChunkBased
         }
         else if (remaining)
         {
-          *this = tIteratorImplementation(**next_chunk, remaining);
+          *this = tIteratorImplementation(*next_chunk, next_chunk_capacity, next_chunk_capacity * CHUNK_SIZE_INCREASE_FACTOR, remaining);
         }
         else
         {
@@ -334,24 +899,53 @@ struct ArrayChunkBased
 
     protected:
 
-      template <size_t SIZE>
-      tIteratorImplementation(tArrayChunk<SIZE>& chunk, size_t set_size) :
-        current_array_entry(set_size ? (&chunk.buffers[0]) : NULL),
-        past_last_array_entry((&chunk.buffers[std::min(SIZE, set_size)])),
+      /*!
+       * \param chunk Pointer to first element in chunk
+       * \param chunk_capacity Number of slots in chunk
+       * \param next_chunk_capacity Number of slots in next chunk
+       * \param set_size Number of slots to iterate over
+       * \param offset Index of first slot in chunk to iterate over
+       */
+      tIteratorImplementation(typename std::conditional<CONST, const tArrayElement*, tArrayElement*>::type chunk, size_t chunk_capacity, size_t next_chunk_capacity, size_t set_size, size_t offset = 0) :
+        current_array_entry(set_size ? (chunk + offset) : NULL),
+        past_last_array_entry(chunk + std::min(chunk_capacity, offset + set_size)),
         remaining(set_size),
-        next_chunk(&chunk.next_chunk),
-        current_element(remaining ? static_cast<T>(*current_array_entry) : static_cast<T>(TNullElement::cNULL_ELEMENT))
+        next_chunk(NextChunkPointer(chunk, chunk_capacity)),
+        next_chunk_capacity(next_chunk_capacity),
+        current_element(remaining ? static_cast<tElement>(*current_array_entry) : static_cast<tElement>(TNullElement::cNULL_ELEMENT))
       {
       }
 
-      template <size_t SIZE>
-      tIteratorImplementation(const tArrayChunk<SIZE>& chunk, size_t set_size) :
-        current_array_entry(set_size ? (&chunk.buffers[0]) : NULL),
-        past_last_array_entry((&chunk.buffers[std::min(SIZE, set_size)])),
-        remaining(set_size),
-        next_chunk(&chunk.next_chunk),
-        current_element(remaining ? static_cast<T>(*current_array_entry) : static_cast<T>(TNullElement::cNULL_ELEMENT))
+      /*!
+       * Creates iterator over range of slots
+       *
+       * \param instance Set instance
+       * \param first_slot Index of first slot to iterate over
+       * \param slot_count Number of slots to iterate over
+       */
+      static tIteratorImplementation CreateForSlots(typename std::conditional<CONST, const tInstance, tInstance>::type& instance, size_t first_slot, size_t slot_count)
       {
+        size_t size = instance.size;
+        first_slot = std::min(first_slot, size);
+        slot_count = std::min(slot_count, size - first_slot);
+        if (first_slot < INITIAL_CHUNK_SIZE)
+        {
+          return tIteratorImplementation(instance.first_chunk.buffers.data(), INITIAL_CHUNK_SIZE, FURTHER_CHUNKS_SIZE, slot_count, first_slot);
+        }
+        if (!slot_count)
+        {
+          return tIteratorImplementation();
+        }
+        first_slot -= INITIAL_CHUNK_SIZE;
+        tFurtherChunk* chunk = instance.first_chunk.next_chunk;
+        size_t chunk_capacity = FURTHER_CHUNKS_SIZE;
+        while (first_slot >= chunk_capacity)
+        {
+          chunk = *NextChunkPointer(chunk, chunk_capacity);
+          first_slot -= chunk_capacity;
+          chunk_capacity *= CHUNK_SIZE_INCREASE_FACTOR;
+        }
+        return tIteratorImplementation(chunk, chunk_capacity, chunk_capacity * CHUNK_SIZE_INCREASE_FACTOR, slot_count, first_slot);
       }
 
       tIteratorImplementation() :
@@ -359,6 +953,7 @@ struct ArrayChunkBased
         past_last_array_entry(NULL),
         remaining(0),
         next_chunk(),
+        next_chunk_capacity(0),
         current_element(TNullElement::cNULL_ELEMENT)
       {
       }
@@ -380,8 +975,11 @@ struct ArrayChunkBased
       /*! Pointer to next chunk */
       typename std::conditional<CONST, const tFurtherChunkPointer*, tFurtherChunkPointer*>::type next_chunk;
 
+      /*! Number of slots in next chunk */
+      size_t next_chunk_capacity;
+
       /*! Current element */
-      T current_element;
+      tElement current_element;
 
     };
 
@@ -390,18 +988,41 @@ struct ArrayChunkBased
     class tIteratorInternal : public tIteratorImplementation<CONST>
     {
       friend class tInstance;
+
+      /*! \return Generation of current slot */
+      uint32_t& CurrentSlotGeneration() const
+      {
+        return SlotGeneration(this->current_array_entry, this->next_chunk);
+      }
+
       template <size_t X = INITIAL_CHUNK_SIZE>
-      tIteratorInternal(typename std::enable_if < X != 0, typename std::conditional<CONST, const tInstance, tInstance>::type >::type& instance) : tIteratorImplementation<CONST>(instance.first_chunk, instance.size) {}
+      tIteratorInternal(typename std::enable_if < X != 0, typename std::conditional<CONST, const tInstance, tInstance>::type >::type& instance) : tIteratorImplementation<CONST>(instance.first_chunk.buffers.data(), INITIAL_CHUNK_SIZE, FURTHER_CHUNKS_SIZE, instance.size) {}
       template <size_t X = INITIAL_CHUNK_SIZE>
-      tIteratorInternal(typename std::enable_if <X == 0, typename std::conditional<CONST, const tInstance, tInstance>::type>::type& instance) : tIteratorImplementation<CONST>(*instance.first_chunk.next_chunk, instance.size) {}
+      tIteratorInternal(typename std::enable_if <X == 0, typename std::conditional<CONST, const tInstance, tInstance>::type>::type& instance) : tIteratorImplementation<CONST>(instance.first_chunk.next_chunk, FURTHER_CHUNKS_SIZE, FURTHER_CHUNKS_SIZE * CHUNK_SIZE_INCREASE_FACTOR, instance.size) {}
+      tIteratorInternal(typename std::conditional<CONST, const tInstance, tInstance>::type& instance, size_t first_slot, size_t slot_count) :
+        tIteratorImplementation<CONST>(tIteratorImplementation<CONST>::CreateForSlots(instance, first_slot, slot_count))
+      {}
       tIteratorInternal() : tIteratorImplementation<CONST>() {}
     };
 
-    /*! External iterator (for use by users of set) - excludes null entries */
-    class tConstIterator : public tIteratorInternal<true>
+    /*!
+     * External iterator (for use by users of set) - excludes null entries
+     * (read section is the first base class, so that it is entered before the first element is loaded)
+     */
+    class tConstIterator : private tDeleter::tReadSection, public tIteratorInternal<true>
     {
     public:
-      tConstIterator(const tInstance& instance) : tIteratorInternal<true>(instance)
+      tConstIterator(const tInstance& instance) : tDeleter::tReadSection(static_cast<const tDeleter&>(instance)), tIteratorInternal<true>(instance)
+      {
+        if (this->current_element == TNullElement::cNULL_ELEMENT && this->remaining)
+        {
+          operator++();
+        }
+      }
+
+      tConstIterator(const tInstance& instance, size_t first_slot, size_t slot_count) :
+        tDeleter::tReadSection(static_cast<const tDeleter&>(instance)),
+        tIteratorInternal<true>(instance, first_slot, slot_count)
       {
         if (this->current_element == TNullElement::cNULL_ELEMENT && this->remaining)
         {
@@ -438,6 +1059,237 @@ struct ArrayChunkBased
 
     /*! Number of slots used */
     tSize size;
+
+    /*! Has Reserve() been called? (then, allocating further chunks is unexpected) */
+    bool reserved;
+
+    /*!
+     * Modification counter (seqlock).
+     * Is incremented before and after any modification of set - so it is odd while set is being modified.
+     */
+    tSize modification_counter;
+
+    /*!
+     * Marks modification of set (in modification counter) - from first call of Begin() until destruction.
+     * Must only be used with mutex acquired.
+     */
+    class tModification
+    {
+    public:
+      tModification(tInstance& instance) : instance(instance), active(false) {}
+
+      ~tModification()
+      {
+        if (active)
+        {
+          instance.modification_counter++;
+        }
+      }
+
+      /*! Marks begin of modification (must be called before set is modified; further calls have no effect) */
+      void Begin()
+      {
+        if (!active)
+        {
+          instance.modification_counter++;
+          active = true;
+        }
+      }
+
+      /*!
+       * Logs change in change log (if enabled). Begin() must have been called.
+       *
+       * \param element Element that is added or removed
+       * \param added True if element is added - false if it is removed
+       */
+      void LogChange(const tElement& element, bool added)
+      {
+        instance.tChangeLogBase::LogChange((instance.modification_counter + 1) / 2, element, added);
+      }
+
+    private:
+
+      tInstance& instance;
+      bool active;
+    };
+
+    /*!
+     * \param array_element Array element to load element from
+     * \return Element
+     */
+    static tElement LoadElement(const std::atomic<tElement>& array_element)
+    {
+      return array_element.load(std::memory_order_acquire);
+    }
+    static tElement LoadElement(const tElement& array_element)
+    {
+      return array_element;
+    }
+
+    /*!
+     * Slot generations are stored in each chunk directly after the pointer to the next chunk - in reverse order,
+     * so that they can be found without knowing the chunk's capacity.
+     * A slot's generation is incremented whenever an element is put into or removed from the slot - so it is odd while the slot is used.
+     * Handles store the generation, so that they do not remove elements that were added to the slot later.
+     * Generations are only accessed with mutex acquired.
+     *
+     * \param slot Slot
+     * \param next_chunk Pointer to next chunk in slot's chunk
+     * \return Generation of slot
+     */
+    static uint32_t& SlotGeneration(const tArrayElement* slot, const tFurtherChunkPointer* next_chunk)
+    {
+      uint32_t* generations = reinterpret_cast<uint32_t*>(const_cast<tFurtherChunkPointer*>(next_chunk + 1));
+      return generations[reinterpret_cast<const tArrayElement*>(next_chunk) - slot - 1];
+    }
+
+    /*!
+     * Increments slot generation of a free slot that an element is put into (generation becomes odd)
+     *
+     * \param generation Generation of slot
+     */
+    static void MarkSlotUsed(uint32_t& generation)
+    {
+      assert((generation & 1) == 0);
+      generation++;
+    }
+
+    /*!
+     * Increments slot generation of a slot that an element is removed from (generation becomes even)
+     *
+     * \param generation Generation of slot
+     */
+    static void MarkSlotFree(uint32_t& generation)
+    {
+      assert(generation & 1);
+      generation++;
+    }
+
+    /*!
+     * Decreases size, so that last used slot is not a free slot.
+     * Only the free slots at the back are visited - starting with the chunk that contains the last used slot.
+     * Whenever the beginning of a chunk is reached, the previous chunk is looked up from the first chunk.
+     *
+     * \param modification Modification of set (mutex must be acquired)
+     */
+    void RemoveFreeSlotsAtBack(tModification& modification)
+    {
+      size_t new_size = size;
+      while (new_size)
+      {
+        // Look up chunk that contains slot 'new_size - 1'
+        tArrayElement* chunk = first_chunk.buffers.data();
+        size_t chunk_capacity = INITIAL_CHUNK_SIZE;
+        size_t next_chunk_capacity = FURTHER_CHUNKS_SIZE;
+        size_t chunk_start = 0;
+        while (new_size > chunk_start + chunk_capacity)
+        {
+          chunk = *NextChunkPointer(chunk, chunk_capacity);
+          chunk_start += chunk_capacity;
+          chunk_capacity = next_chunk_capacity;
+          next_chunk_capacity *= CHUNK_SIZE_INCREASE_FACTOR;
+        }
+
+        while (new_size > chunk_start && LoadElement(chunk[new_size - chunk_start - 1]) == TNullElement::cNULL_ELEMENT)
+        {
+          new_size--;
+        }
+        if (new_size > chunk_start)
+        {
+          break;
+        }
+      }
+      if (new_size != size)
+      {
+        modification.Begin();
+        size = new_size;
+      }
+    }
+
+    /*!
+     * \param capacity Number of slots in chunk
+     * \return Newly allocated and initialized further chunk
+     */
+    tFurtherChunk* AllocateChunk(size_t capacity)
+    {
+      tChunkAllocator allocator(static_cast<TAllocator&>(*this));
+      tFurtherChunk* chunk = reinterpret_cast<tFurtherChunk*>(std::allocator_traits<tChunkAllocator>::allocate(allocator, ChunkUnits(capacity)));
+      for (size_t i = 0; i < capacity; i++)
+      {
+        new(&chunk[i]) tArrayElement();
+      }
+      tFurtherChunkPointer* next_chunk = NextChunkPointer(chunk, capacity);
+      new(next_chunk) tFurtherChunkPointer(NULL);
+      for (size_t i = 0; i < capacity; i++)
+      {
+        new(&SlotGeneration(&chunk[i], next_chunk)) uint32_t(0);
+      }
+      return chunk;
+    }
+
+    /*!
+     * \param chunk Further chunk to deallocate
+     * \param capacity Number of slots in chunk
+     */
+    void DeallocateChunk(tFurtherChunk* chunk, size_t capacity)
+    {
+      tChunkAllocator allocator(static_cast<TAllocator&>(*this));
+      std::allocator_traits<tChunkAllocator>::deallocate(allocator, reinterpret_cast<tChunkUnit*>(chunk), ChunkUnits(capacity));
+    }
+
+    /*!
+     * \param capacity Number of slots in chunk
+     * \return Number of units to allocate for chunk
+     */
+    static size_t ChunkUnits(size_t capacity)
+    {
+      return (capacity * (sizeof(tArrayElement) + sizeof(uint32_t)) + sizeof(tFurtherChunkPointer) + sizeof(tChunkUnit) - 1) / sizeof(tChunkUnit);
+    }
+
+    /*!
+     * \param chunk Pointer to first element in chunk
+     * \param capacity Number of slots in chunk
+     * \return Pointer to chunk's pointer to next chunk (located directly after its elements)
+     */
+    static tFurtherChunkPointer* NextChunkPointer(tArrayElement* chunk, size_t capacity)
+    {
+      return reinterpret_cast<tFurtherChunkPointer*>(chunk + capacity);
+    }
+    static const tFurtherChunkPointer* NextChunkPointer(const tArrayElement* chunk, size_t capacity)
+    {
+      return reinterpret_cast<const tFurtherChunkPointer*>(chunk + capacity);
+    }
+
+    /*!
+     * Appends element after the last used slot (allocates new chunk if required)
+     *
+     * \param element Element to append
+     * \param end Internal iterator that has passed the last used slot. Is updated so that further elements can be appended.
+     */
+    void Append(const tElement& element, tIteratorInternal<false>& end)
+    {
+      if ((void*)end.past_last_array_entry != (void*)end.next_chunk)
+      {
+        *end.past_last_array_entry = element;
+        end.past_last_array_entry++;
+      }
+      else
+      {
+        tFurtherChunk* next_chunk = *end.next_chunk;  // chunks are kept when set shrinks
+        if (!next_chunk)
+        {
+          assert((!reserved) && "Set exceeds capacity reserved with Reserve(). Memory is allocated. Please reserve more.");
+          next_chunk = AllocateChunk(end.next_chunk_capacity);
+          *end.next_chunk = next_chunk;
+        }
+        next_chunk[0] = element;
+        end.past_last_array_entry = &next_chunk[1];
+        end.next_chunk = NextChunkPointer(next_chunk, end.next_chunk_capacity);
+        end.next_chunk_capacity *= CHUNK_SIZE_INCREASE_FACTOR;
+      }
+      MarkSlotUsed(SlotGeneration(end.past_last_array_entry - 1, end.next_chunk));
+      size++; // important: do this last (modification must already be marked)
+    }
   };
 
 };
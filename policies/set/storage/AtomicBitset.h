@@ -0,0 +1,390 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/policies/set/storage/AtomicBitset.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains AtomicBitset
+ *
+ * \b AtomicBitset
+ *
+ * Set storage for small non-negative integers (e.g. IDs) in a bounded domain.
+ * Every possible element is represented by one bit in an array of atomic 64 bit words.
+ * Add, Remove and Contains are lock-free O(1) operations.
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__concurrent_containers__policies__set__storage__AtomicBitset_h__
+#define __rrlib__concurrent_containers__policies__set__storage__AtomicBitset_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include <array>
+#include <cstdint>
+#include "rrlib/util/tNoncopyable.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+namespace set
+{
+namespace storage
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Set storage for small integers based on an atomic bitset.
+/*!
+ * Set storage for integral types with elements in the domain [0, DOMAIN_SIZE).
+ * Every possible element is represented by one bit in an array of atomic 64 bit words -
+ * so the memory footprint is DOMAIN_SIZE / 8 bytes (and 64 times smaller than storing elements in 64 bit slots).
+ *
+ * All operations are lock-free and may be called concurrently - so the TMutex parameter of tSet is not used.
+ * Add and Remove set and clear bits with fetch_or and fetch_and operations.
+ * Contains is an O(1) operation. Iterating skips empty words and finds set bits with 'count trailing zeros' instructions.
+ * Elements are iterated in ascending order.
+ *
+ * Duplicates are not supported (tAllowDuplicates::NO only).
+ * The null element (0 by default) may not be added to the set (as with any other storage policy).
+ *
+ * \tparam DOMAIN_SIZE Elements must be smaller than this value
+ */
+template <size_t DOMAIN_SIZE>
+struct AtomicBitset
+{
+  static_assert(DOMAIN_SIZE > 0, "Domain must not be empty");
+
+  template <typename T, tAllowDuplicates ALLOW_DUPLICATES, typename TMutex, typename TNullElement, bool DEREFERENCING_ITERATOR>
+  class tInstance : private rrlib::util::tNoncopyable
+  {
+    static_assert(std::is_integral<T>::value, "AtomicBitset only supports integral types");
+    static_assert(ALLOW_DUPLICATES == tAllowDuplicates::NO, "AtomicBitset cannot store duplicates");
+    static_assert(!DEREFERENCING_ITERATOR, "Integral elements cannot be dereferenced");
+
+    enum { cWORD_COUNT = (DOMAIN_SIZE + 63) / 64 };
+
+    typedef std::atomic<uint64_t> tWord;
+
+    //----------------------------------------------------------------------
+    // Public methods and typedefs
+    //----------------------------------------------------------------------
+  public:
+
+    /*! Type of elements stored in set */
+    typedef T tElement;
+
+    // Iterator types
+    class tConstIterator;
+
+    /*! Handle to element in set (elements can be removed in O(1) anyway) */
+    class tHandle
+    {
+    public:
+      tHandle() : element(TNullElement::cNULL_ELEMENT) {}
+
+    private:
+      friend class tInstance;
+
+      explicit tHandle(T element) : element(element) {}
+
+      /*! Element that was added */
+      T element;
+    };
+
+    tInstance()
+    {
+      for (auto it = words.begin(); it != words.end(); ++it)
+      {
+        it->store(0, std::memory_order_relaxed);
+      }
+    }
+
+    tHandle Add(const T& element)
+    {
+      if (!InDomain(element))
+      {
+        RRLIB_LOG_PRINT(ERROR, "Element ", element, " is outside of the set's domain [0, ", DOMAIN_SIZE, "). Ignoring.");
+        return tHandle();
+      }
+      Word(element).fetch_or(Bit(element));
+      return tHandle(element);
+    }
+
+    template <typename TIterator>
+    void AddRange(TIterator begin, TIterator end)
+    {
+      for (; begin != end; ++begin)
+      {
+        if (*begin != TNullElement::cNULL_ELEMENT)
+        {
+          Add(*begin);
+        }
+      }
+    }
+
+    tConstIterator Begin() const
+    {
+      return tConstIterator(*this, 0);
+    }
+
+    void Clear()
+    {
+      for (auto it = words.begin(); it != words.end(); ++it)
+      {
+        it->store(0);
+      }
+    }
+
+    bool Contains(const T& element) const
+    {
+      return InDomain(element) && (Word(element).load() & Bit(element)) != 0;
+    }
+
+    bool Empty() const
+    {
+      for (auto it = words.begin(); it != words.end(); ++it)
+      {
+        if (it->load())
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    tConstIterator End() const
+    {
+      return tConstIterator();
+    }
+
+    tConstIterator Remove(tConstIterator position)
+    {
+      Remove(position.current_element);
+      ++position;
+      return position;
+    }
+
+    void Remove(const tHandle& handle)
+    {
+      if (handle.element != TNullElement::cNULL_ELEMENT)
+      {
+        Remove(handle.element);
+      }
+    }
+
+    void Remove(const T& element)
+    {
+      if (InDomain(element))
+      {
+        Word(element).fetch_and(~Bit(element));
+      }
+    }
+
+    template <typename TIterator>
+    void RemoveAll(TIterator begin, TIterator end)
+    {
+      for (; begin != end; ++begin)
+      {
+        Remove(*begin);
+      }
+    }
+
+    template <typename TPredicate>
+    void RemoveIf(TPredicate predicate)
+    {
+      for (size_t i = 0; i < cWORD_COUNT; i++)
+      {
+        uint64_t bits = words[i].load();
+        uint64_t remove_mask = 0;
+        while (bits)
+        {
+          int bit = __builtin_ctzll(bits);
+          bits &= bits - 1;
+          if (predicate(static_cast<T>(i * 64 + bit)))
+          {
+            remove_mask |= (static_cast<uint64_t>(1) << bit);
+          }
+        }
+        if (remove_mask)
+        {
+          words[i].fetch_and(~remove_mask);
+        }
+      }
+    }
+
+    /*! Iterator (for use by users of set) */
+    class tConstIterator : public std::iterator<std::input_iterator_tag, const T, size_t>
+    {
+      typedef std::iterator<std::input_iterator_tag, const T, size_t> tBase;
+
+    public:
+
+      tConstIterator() :
+        instance(NULL),
+        word_index(cWORD_COUNT),
+        remaining_bits(0),
+        current_element(TNullElement::cNULL_ELEMENT)
+      {}
+
+      // Operators needed for C++ Input Iterator
+
+      inline typename tBase::reference operator*() const
+      {
+        assert(instance);
+        return current_element;
+      }
+      inline typename tBase::pointer operator->() const
+      {
+        return &(operator*());
+      }
+
+      inline tConstIterator& operator++()
+      {
+        remaining_bits &= remaining_bits - 1;
+        SkipEmptyWords();
+        return *this;
+      }
+      inline tConstIterator operator ++ (int)
+      {
+        tConstIterator temp(*this);
+        operator++();
+        return temp;
+      }
+
+      inline const bool operator == (const tConstIterator &other) const
+      {
+        return word_index == other.word_index && remaining_bits == other.remaining_bits;
+      }
+      inline const bool operator != (const tConstIterator &other) const
+      {
+        return !(*this == other);
+      }
+
+    private:
+
+      friend class tInstance;
+
+      tConstIterator(const tInstance& instance, size_t word_index) :
+        instance(&instance),
+        word_index(word_index),
+        remaining_bits(instance.words[word_index].load()),
+        current_element(TNullElement::cNULL_ELEMENT)
+      {
+        SkipEmptyWords();
+      }
+
+      /*!
+       * Moves iterator forward to the next set bit (starting with the current word's remaining bits)
+       * (or past the end)
+       */
+      void SkipEmptyWords()
+      {
+        while (!remaining_bits)
+        {
+          word_index++;
+          if (word_index >= cWORD_COUNT)
+          {
+            *this = tConstIterator();
+            return;
+          }
+          remaining_bits = instance->words[word_index].load();
+        }
+        current_element = static_cast<T>(word_index * 64 + __builtin_ctzll(remaining_bits));
+      }
+
+      /*! Set instance that iterator belongs to (NULL for end iterator) */
+      const tInstance* instance;
+
+      /*! Index of current word */
+      size_t word_index;
+
+      /*! Bits in current word that have not been visited yet (including the current element's bit) */
+      uint64_t remaining_bits;
+
+      /*! Current element */
+      T current_element;
+    };
+
+    //----------------------------------------------------------------------
+    // Private fields and methods
+    //----------------------------------------------------------------------
+  private:
+
+    /*! Bitset words */
+    std::array<tWord, cWORD_COUNT> words;
+
+    /*!
+     * \return True if element is in set's domain
+     */
+    static bool InDomain(const T& element)
+    {
+      return element >= 0 && static_cast<uint64_t>(element) < DOMAIN_SIZE;
+    }
+
+    /*!
+     * \return Bit mask of element in its word
+     */
+    static uint64_t Bit(const T& element)
+    {
+      return static_cast<uint64_t>(1) << (static_cast<uint64_t>(element) % 64);
+    }
+
+    /*!
+     * \return Word containing element's bit
+     */
+    tWord& Word(const T& element)
+    {
+      return words[static_cast<uint64_t>(element) / 64];
+    }
+    const tWord& Word(const T& element) const
+    {
+      return words[static_cast<uint64_t>(element) / 64];
+    }
+  };
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,636 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/policies/set/storage/LockFreeArrayChunkBased.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains LockFreeArrayChunkBased
+ *
+ * \b LockFreeArrayChunkBased
+ *
+ * Set storage based on singly-linked array chunks - with lock-free modifications.
+ * Like ArrayChunkBased, but Add and Remove never acquire a mutex:
+ * Slots are claimed and released with compare-and-swap operations
+ * and new chunks are appended with a compare-and-swap operation on 'next_chunk'.
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__concurrent_containers__policies__set__storage__LockFreeArrayChunkBased_h__
+#define __rrlib__concurrent_containers__policies__set__storage__LockFreeArrayChunkBased_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include "rrlib/util/tNoncopyable.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+namespace set
+{
+namespace storage
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Set storage based on singly-linked array chunks with lock-free modifications.
+/*!
+ * Set storage based on singly-linked array chunks - with lock-free modifications.
+ * Set entries are stored in array chunks:
+ *  Whenever the capacity is insufficient, another array chunk is appended.
+ *
+ * In contrast to ArrayChunkBased, all operations (Add, Remove, Clear and iterating)
+ * may be called concurrently without acquiring any mutex - so the TMutex parameter of tSet is not used.
+ * Add claims the first free slot with a compare-and-swap operation. Remove releases slots
+ * with compare-and-swap operations. Chunks are never deallocated before the set is deleted,
+ * so iterators can always safely proceed.
+ *
+ * With tAllowDuplicates::NO, elements are added using a 'claim-then-validate' protocol:
+ * A thread first claims a slot for the element and then scans the whole set.
+ * If it finds the same element in a slot before its own, it releases its own slot.
+ * If it finds the same element in a slot after its own, it releases that slot.
+ * The copy in the first slot therefore always survives and, as all atomic operations
+ * are sequentially consistent, at least one of two concurrent adders sees the other's copy
+ * - so that no duplicates remain once Add calls have returned.
+ * If Add and Remove are called concurrently for the same element, either result is possible.
+ *
+ * Each slot has a state word with a generation counter that is incremented whenever an element is removed from it.
+ * Handles store this generation - so they cannot remove an element that was added to the same slot later.
+ *
+ * Compared to ArrayChunkBased, iterating is a little more expensive, since
+ * all slots in all chunks are visited (there is no size tracking the last used slot).
+ *
+ * \tparam INITIAL_CHUNK_SIZE Entries/slots in initial chunk
+ * \tparam FURTHER_CHUNKS_SIZE Entries/slots in any further appended chunks
+ */
+template <size_t INITIAL_CHUNK_SIZE, size_t FURTHER_CHUNKS_SIZE>
+struct LockFreeArrayChunkBased
+{
+  static_assert(FURTHER_CHUNKS_SIZE > 0, "Further chunks must have at least one slot");
+
+  /*! Helper struct to realize optional iterator dereferencing */
+  template <typename T, bool DEREFERENCE>
+  struct IteratorCustomization
+  {
+    typedef const T tReturnType;
+  };
+
+  template <typename T>
+  struct IteratorCustomization<T, true>
+  {
+    typedef typename std::remove_pointer<T>::type tReturnType;
+  };
+
+  template <typename T, tAllowDuplicates ALLOW_DUPLICATES, typename TMutex, typename TNullElement, bool DEREFERENCING_ITERATOR>
+  class tInstance : private rrlib::util::tNoncopyable
+  {
+    /*! The set storage is a linked list of array chunks */
+    template <size_t SIZE>
+    struct tArrayChunk;
+
+    typedef tArrayChunk<INITIAL_CHUNK_SIZE> tFirstChunk;
+    typedef tArrayChunk<FURTHER_CHUNKS_SIZE> tFurtherChunk;
+    typedef std::atomic<T> tArrayElement;
+
+    /*!
+     * State of slot: generation counter (incremented whenever element is removed from slot) in upper bits,
+     * one of the slot states below in the lower two bits
+     */
+    typedef std::atomic<uint32_t> tSlotState;
+
+    enum { cSLOT_FREE = 0, cSLOT_OCCUPIED = 1, cSLOT_REMOVING = 2, cSLOT_STATE_MASK = 3, cGENERATION_SHIFT = 2 };
+
+    template <size_t SIZE>
+    struct tArrayChunk
+    {
+      /*! Buffers in array chunk. Null element for free slots. */
+      std::array<tArrayElement, SIZE> buffers;
+
+      /*! Pointer to next chunk -> linked-list */
+      std::atomic<tFurtherChunk*> next_chunk;
+
+      /*! States of slots (separate array, so that iterating over buffers stays cache-friendly) */
+      std::array<tSlotState, SIZE> states;
+
+      static_assert(SIZE == 0 || sizeof(buffers) % sizeof(next_chunk) == 0, "Please choose a chunk size that does not waste memory");
+
+      tArrayChunk() : next_chunk(NULL)
+      {
+        for (auto it = buffers.begin(); it != buffers.end(); ++it)
+        {
+          it->store(static_cast<T>(TNullElement::cNULL_ELEMENT), std::memory_order_relaxed);
+        }
+        for (auto it = states.begin(); it != states.end(); ++it)
+        {
+          it->store(cSLOT_FREE, std::memory_order_relaxed);
+        }
+      }
+
+      ~tArrayChunk()
+      {
+        delete next_chunk.load();
+      }
+    };
+
+    //----------------------------------------------------------------------
+    // Public methods and typedefs
+    //----------------------------------------------------------------------
+  public:
+
+    /*! Type of elements stored in set (owning sets of unique pointers are not supported by this policy) */
+    typedef T tElement;
+
+    // Iterator types
+    class tConstIterator;
+
+    /*! Handle to element in set (slot in chunk and slot generation when element was added) */
+    class tHandle
+    {
+    public:
+      tHandle() : slot(NULL), state(NULL), generation(0) {}
+
+    private:
+      friend class tInstance;
+
+      tHandle(tArrayElement* slot, tSlotState* state, uint32_t generation) : slot(slot), state(state), generation(generation) {}
+
+      /*! Slot that element was added to (NULL for invalid handle) */
+      tArrayElement* slot;
+
+      /*! State of slot */
+      tSlotState* state;
+
+      /*! Generation of slot while element is in it */
+      uint32_t generation;
+    };
+
+    tInstance() : element_count(0) {}
+
+    tHandle Add(const T& element)
+    {
+      if (ALLOW_DUPLICATES == tAllowDuplicates::NO)
+      {
+        for (tIteratorInternal it(*this); it.current_array_entry; it.Next())
+        {
+          if (it.current_element == element)
+          {
+            return it.CreateHandle();
+          }
+        }
+      }
+
+      tHandle handle = ClaimSlot(element);
+      tArrayElement* slot = handle.slot;
+      element_count++;
+
+      if (ALLOW_DUPLICATES == tAllowDuplicates::NO)
+      {
+        // Validate: only the copy in the first slot may remain
+        bool own_slot_passed = false;
+        for (tIteratorInternal it(*this); it.current_array_entry; it.Next())
+        {
+          if (it.current_array_entry == slot)
+          {
+            own_slot_passed = true;
+          }
+          else if (it.current_element == element)
+          {
+            if (!own_slot_passed)
+            {
+              ReleaseSlot(*slot, *handle.state, element);
+              return it.CreateHandle();
+            }
+            ReleaseSlot(*it.current_array_entry, *it.current_state, element);
+          }
+        }
+      }
+      return handle;
+    }
+
+    template <typename TIterator>
+    void AddRange(TIterator begin, TIterator end)
+    {
+      for (; begin != end; ++begin)
+      {
+        if (*begin != TNullElement::cNULL_ELEMENT)
+        {
+          Add(*begin);
+        }
+      }
+    }
+
+    tConstIterator Begin() const
+    {
+      return tConstIterator(*this);
+    }
+
+    void Clear()
+    {
+      for (tIteratorInternal it(*this); it.current_array_entry; it.Next())
+      {
+        if (it.current_element != TNullElement::cNULL_ELEMENT)
+        {
+          ReleaseSlot(*it.current_array_entry, *it.current_state, it.current_element);
+        }
+      }
+    }
+
+    bool Contains(const T& element) const
+    {
+      for (tIteratorInternal it(const_cast<tInstance&>(*this)); it.current_array_entry; it.Next())
+      {
+        if (it.current_element == element)
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    bool Empty() const
+    {
+      return element_count.load() <= 0;
+    }
+
+    tConstIterator End() const
+    {
+      return tConstIterator();
+    }
+
+    tConstIterator Remove(tConstIterator position)
+    {
+      ReleaseSlot(*const_cast<tArrayElement*>(position.current_array_entry), *const_cast<tSlotState*>(position.current_state), position.current_element);
+      ++position;
+      return position;
+    }
+
+    void Remove(const tHandle& handle)
+    {
+      uint32_t expected_state = (handle.generation << cGENERATION_SHIFT) | cSLOT_OCCUPIED;
+      if (handle.slot && handle.state->compare_exchange_strong(expected_state, (handle.generation << cGENERATION_SHIFT) | cSLOT_REMOVING))
+      {
+        FreeSlot(*handle.slot, *handle.state, handle.generation);
+      }
+    }
+
+    void Remove(const T& element)
+    {
+      RemoveIf([&element](const T & current_element)
+      {
+        return current_element == element;
+      });
+    }
+
+    template <typename TIterator>
+    void RemoveAll(TIterator begin, TIterator end)
+    {
+      std::vector<T> sorted_batch(begin, end);
+      std::sort(sorted_batch.begin(), sorted_batch.end());
+      RemoveIf([&sorted_batch](const T & current_element)
+      {
+        return std::binary_search(sorted_batch.begin(), sorted_batch.end(), current_element);
+      });
+    }
+
+    template <typename TPredicate>
+    void RemoveIf(TPredicate predicate)
+    {
+      for (tIteratorInternal it(*this); it.current_array_entry; it.Next())
+      {
+        if (it.current_element != TNullElement::cNULL_ELEMENT && predicate(it.current_element))
+        {
+          ReleaseSlot(*it.current_array_entry, *it.current_state, it.current_element);
+        }
+      }
+    }
+
+    /*! External iterator (for use by users of set) - excludes null entries */
+    class tConstIterator : public std::iterator<std::input_iterator_tag, typename IteratorCustomization<T, DEREFERENCING_ITERATOR>::tReturnType, size_t>
+    {
+      typedef std::iterator<std::input_iterator_tag, typename IteratorCustomization<T, DEREFERENCING_ITERATOR>::tReturnType, size_t> tBase;
+
+    public:
+
+      tConstIterator() :
+        current_array_entry(NULL),
+        past_last_array_entry(NULL),
+        current_state(NULL),
+        next_chunk(NULL),
+        current_element(TNullElement::cNULL_ELEMENT)
+      {}
+
+      // Operators needed for C++ Input Iterator
+
+      template <bool DEREF = DEREFERENCING_ITERATOR>
+      inline typename std::enable_if < !DEREF, typename tBase::reference >::type operator*() const
+      {
+        assert(current_array_entry);
+        return current_element;
+      }
+      template <bool DEREF = DEREFERENCING_ITERATOR>
+      inline typename std::enable_if<DEREF, typename tBase::reference>::type operator*() const
+      {
+        assert(current_array_entry);
+        return *current_element;
+      }
+      inline typename tBase::pointer operator->() const
+      {
+        return &(operator*());
+      }
+
+      inline tConstIterator& operator++()
+      {
+        current_array_entry++;
+        current_state++;
+        SkipFreeSlots();
+        return *this;
+      }
+      inline tConstIterator operator ++ (int)
+      {
+        tConstIterator temp(*this);
+        operator++();
+        return temp;
+      }
+
+      inline const bool operator == (const tConstIterator &other) const
+      {
+        return current_array_entry == other.current_array_entry;
+      }
+      inline const bool operator != (const tConstIterator &other) const
+      {
+        return !(*this == other);
+      }
+
+    private:
+
+      friend class tInstance;
+
+      tConstIterator(const tInstance& instance) :
+        current_array_entry(instance.first_chunk.buffers.data()),
+        past_last_array_entry(instance.first_chunk.buffers.data() + INITIAL_CHUNK_SIZE),
+        current_state(instance.first_chunk.states.data()),
+        next_chunk(&instance.first_chunk.next_chunk),
+        current_element(TNullElement::cNULL_ELEMENT)
+      {
+        SkipFreeSlots();
+      }
+
+      /*!
+       * Moves iterator forward to the next slot (starting with the current one) that contains an element
+       * (or past the end)
+       */
+      void SkipFreeSlots()
+      {
+        while (true)
+        {
+          if (current_array_entry == past_last_array_entry)
+          {
+            const tFurtherChunk* chunk = next_chunk->load();
+            if (!chunk)
+            {
+              current_array_entry = NULL;
+              return;
+            }
+            current_array_entry = chunk->buffers.data();
+            past_last_array_entry = current_array_entry + FURTHER_CHUNKS_SIZE;
+            current_state = chunk->states.data();
+            next_chunk = &chunk->next_chunk;
+          }
+          current_element = current_array_entry->load();
+          if (current_element != TNullElement::cNULL_ELEMENT)
+          {
+            return;
+          }
+          current_array_entry++;
+          current_state++;
+        }
+      }
+
+      /*! Pointer to current element */
+      const tArrayElement* current_array_entry;
+
+      /*! Last element in array chunk */
+      const tArrayElement* past_last_array_entry;
+
+      /*! State of current slot */
+      const tSlotState* current_state;
+
+      /*! Pointer to next chunk */
+      const std::atomic<tFurtherChunk*>* next_chunk;
+
+      /*! Current element */
+      T current_element;
+    };
+
+    //----------------------------------------------------------------------
+    // Private fields and methods
+    //----------------------------------------------------------------------
+  private:
+
+    /*! Internal iterator (for inside this class file only) - includes null entries */
+    struct tIteratorInternal
+    {
+      tIteratorInternal(tInstance& instance) :
+        current_array_entry(instance.first_chunk.buffers.data()),
+        past_last_array_entry(instance.first_chunk.buffers.data() + INITIAL_CHUNK_SIZE),
+        current_state(instance.first_chunk.states.data()),
+        next_chunk(&instance.first_chunk.next_chunk),
+        current_element(TNullElement::cNULL_ELEMENT)
+      {
+        Load();
+      }
+
+      /*!
+       * \return Handle to current slot (its generation is loaded now - so handle is stale if current element has already been removed)
+       */
+      tHandle CreateHandle() const
+      {
+        return tHandle(current_array_entry, current_state, current_state->load() >> cGENERATION_SHIFT);
+      }
+
+      /*! Moves iterator to next slot (current_array_entry is NULL after last slot) */
+      void Next()
+      {
+        current_array_entry++;
+        current_state++;
+        Load();
+      }
+
+      /*!
+       * Moves iterator to first slot of chunk
+       *
+       * \param chunk Chunk
+       */
+      void SetChunk(tFurtherChunk* chunk)
+      {
+        current_array_entry = chunk->buffers.data();
+        past_last_array_entry = current_array_entry + FURTHER_CHUNKS_SIZE;
+        current_state = chunk->states.data();
+        next_chunk = &chunk->next_chunk;
+      }
+
+      /*! Loads current element - and switches to next chunk if necessary */
+      void Load()
+      {
+        while (current_array_entry == past_last_array_entry)
+        {
+          tFurtherChunk* chunk = next_chunk->load();
+          if (!chunk)
+          {
+            current_array_entry = NULL;
+            return;
+          }
+          SetChunk(chunk);
+        }
+        current_element = current_array_entry->load();
+      }
+
+      /*! Pointer to current slot */
+      tArrayElement* current_array_entry;
+
+      /*! Last slot in array chunk */
+      tArrayElement* past_last_array_entry;
+
+      /*! State of current slot */
+      tSlotState* current_state;
+
+      /*! Pointer to next chunk */
+      std::atomic<tFurtherChunk*>* next_chunk;
+
+      /*! Element in current slot (when loaded) */
+      T current_element;
+    };
+
+    /*! First Chunk */
+    tFirstChunk first_chunk;
+
+    /*! Number of elements in set (may temporarily be inaccurate while elements are added or removed concurrently) */
+    std::atomic<ptrdiff_t> element_count;
+
+    /*!
+     * Claims free slot for element (appends chunk if there is no free slot)
+     *
+     * \param element Element to store in slot
+     * \return Handle to slot that now contains element
+     */
+    tHandle ClaimSlot(const T& element)
+    {
+      tFurtherChunk* spare_chunk = NULL;
+      tIteratorInternal it(*this);
+      while (true)
+      {
+        for (; it.current_array_entry; it.Next())
+        {
+          uint32_t state = it.current_state->load();
+          if (it.current_element == TNullElement::cNULL_ELEMENT && (state & cSLOT_STATE_MASK) == cSLOT_FREE &&
+              it.current_state->compare_exchange_strong(state, state | cSLOT_OCCUPIED))
+          {
+            it.current_array_entry->store(element);
+            delete spare_chunk;
+            return tHandle(it.current_array_entry, it.current_state, state >> cGENERATION_SHIFT);
+          }
+        }
+
+        // No free slot found: try to append chunk (possibly reusing chunk from previous failed attempt)
+        if (!spare_chunk)
+        {
+          spare_chunk = new tFurtherChunk();
+        }
+        spare_chunk->buffers[0].store(element, std::memory_order_relaxed);
+        spare_chunk->states[0].store(cSLOT_OCCUPIED, std::memory_order_relaxed);
+        tFurtherChunk* expected_next = NULL;
+        if (it.next_chunk->compare_exchange_strong(expected_next, spare_chunk))
+        {
+          return tHandle(&spare_chunk->buffers[0], &spare_chunk->states[0], 0);
+        }
+
+        // Another thread appended a chunk: continue search in this one
+        spare_chunk->buffers[0].store(static_cast<T>(TNullElement::cNULL_ELEMENT), std::memory_order_relaxed);
+        spare_chunk->states[0].store(cSLOT_FREE, std::memory_order_relaxed);
+        it.SetChunk(expected_next);
+        it.Load();
+      }
+    }
+
+    /*!
+     * Releases slot - provided that it still contains the specified element
+     *
+     * \param slot Slot to release
+     * \param state State of slot
+     * \param element Element that slot is expected to contain
+     */
+    void ReleaseSlot(tArrayElement& slot, tSlotState& state, T element)
+    {
+      uint32_t current_state = state.load();
+      if ((current_state & cSLOT_STATE_MASK) == cSLOT_OCCUPIED && slot.load() == element &&
+          state.compare_exchange_strong(current_state, (current_state & ~cSLOT_STATE_MASK) | cSLOT_REMOVING))
+      {
+        FreeSlot(slot, state, current_state >> cGENERATION_SHIFT);
+      }
+    }
+
+    /*!
+     * Removes element from slot that this thread has put into cSLOT_REMOVING state
+     *
+     * \param slot Slot to free
+     * \param state State of slot
+     * \param generation Current generation of slot (is incremented)
+     */
+    void FreeSlot(tArrayElement& slot, tSlotState& state, uint32_t generation)
+    {
+      slot.store(static_cast<T>(TNullElement::cNULL_ELEMENT));
+      state.store(((generation + 1) << cGENERATION_SHIFT) | cSLOT_FREE);
+      element_count--;
+    }
+  };
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+}
+
+
+#endif
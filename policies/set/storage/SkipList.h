@@ -0,0 +1,713 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/policies/set/storage/SkipList.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains SkipList
+ *
+ * \b SkipList
+ *
+ * Set storage that keeps elements ordered - based on a lock-free skip list.
+ * Add, Remove and Contains take O(log n) time; iteration is in ascending order.
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__concurrent_containers__policies__set__storage__SkipList_h__
+#define __rrlib__concurrent_containers__policies__set__storage__SkipList_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <thread>
+#include "rrlib/util/tNoncopyable.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tGracePeriods.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+namespace set
+{
+namespace storage
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Ordered set storage based on a lock-free skip list.
+/*!
+ * Set storage that keeps elements ordered by a comparator - based on a lock-free skip list
+ * (as described by Herlihy and Shavit, with marked next pointers as proposed by Harris).
+ *
+ * All operations (Add, Remove, Contains, Clear and iterating) may be called concurrently
+ * without acquiring any mutex - so the TMutex parameter of tSet is not used.
+ * Add, Remove and Contains take O(log n) time. Iterators visit elements in ascending order.
+ * tSet::LowerBound() returns an iterator to the first element that is not smaller than the specified one
+ * - so that ranges of elements can be processed.
+ *
+ * An element is removed by first marking the next pointers of its node (logical deletion).
+ * Marked nodes are then unlinked by any thread that traverses them. Unlinked nodes are deleted
+ * when no read section that might still access them is active (see tGracePeriods).
+ * As iterators are read sections, removed elements are not deleted while iterators exist
+ * (so iterators should not be kept for a long time).
+ *
+ * Duplicates are not supported (tAllowDuplicates::NO only). Two elements are equal if neither is smaller than the other.
+ * Add and Remove allocate and (eventually) free memory - so they are not suitable for real-time threads.
+ *
+ * \tparam TCompare Comparator template (instantiated with the set's element type - must provide strict weak ordering)
+ * \tparam MAX_LEVEL Maximum number of levels (16 levels suit sets with up to about 2^16 elements)
+ */
+template <template <typename> class TCompare = std::less, size_t MAX_LEVEL = 16>
+struct SkipList
+{
+  static_assert(MAX_LEVEL > 0 && MAX_LEVEL <= 32, "MAX_LEVEL must be between 1 and 32");
+
+  /*! Helper struct to realize optional iterator dereferencing */
+  template <typename T, bool DEREFERENCE>
+  struct IteratorCustomization
+  {
+    typedef const T tReturnType;
+  };
+
+  template <typename T>
+  struct IteratorCustomization<T, true>
+  {
+    typedef typename std::remove_pointer<T>::type tReturnType;
+  };
+
+  template <typename T, tAllowDuplicates ALLOW_DUPLICATES, typename TMutex, typename TNullElement, bool DEREFERENCING_ITERATOR>
+  class tInstance : private rrlib::util::tNoncopyable
+  {
+    static_assert(ALLOW_DUPLICATES == tAllowDuplicates::NO, "SkipList cannot store duplicates");
+
+    /*! Skip list node (next pointers of the node's levels are stored directly after it) */
+    struct tNode;
+
+    //----------------------------------------------------------------------
+    // Public methods and typedefs
+    //----------------------------------------------------------------------
+  public:
+
+    /*! Type of elements stored in set */
+    typedef T tElement;
+
+    // Iterator types
+    class tConstIterator;
+
+    /*! Handle to element in set (elements are removed in O(log n) via their value) */
+    class tHandle
+    {
+    public:
+      tHandle() : element(TNullElement::cNULL_ELEMENT) {}
+
+    private:
+      friend class tInstance;
+
+      explicit tHandle(T element) : element(element) {}
+
+      /*! Element that was added */
+      T element;
+    };
+
+    tInstance() :
+      head(CreateNode(static_cast<T>(TNullElement::cNULL_ELEMENT), MAX_LEVEL)),
+      retired(NULL)
+    {}
+
+    ~tInstance()
+    {
+      tNode* node = head;
+      while (node)
+      {
+        tNode* next = Pointer(node->Next()[0].load());
+        DeleteNode(node);
+        node = next;
+      }
+      DeleteNodes(retired.load());
+    }
+
+    tHandle Add(const T& element)
+    {
+      bool retired_node = false;
+      {
+        tGracePeriods::tReadSection read_section(grace_periods);
+        tNode* predecessors[MAX_LEVEL];
+        tNode* successors[MAX_LEVEL];
+        tNode* node = NULL;
+        size_t height = RandomHeight();
+        while (true)
+        {
+          if (Find(element, predecessors, successors))
+          {
+            if (node)
+            {
+              DeleteNode(node);
+            }
+            return tHandle(element);
+          }
+          if (!node)
+          {
+            node = CreateNode(element, height);
+          }
+          for (size_t level = 0; level < height; level++)
+          {
+            node->Next()[level].store(reinterpret_cast<uintptr_t>(successors[level]), std::memory_order_relaxed);
+          }
+          uintptr_t expected = reinterpret_cast<uintptr_t>(successors[0]);
+          if (predecessors[0]->Next()[0].compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(node)))
+          {
+            break;
+          }
+        }
+
+        // Element is in set now: link node in upper levels
+        for (size_t level = 1; level < height; level++)
+        {
+          bool linked = false;
+          while (!linked)
+          {
+            uintptr_t node_next = node->Next()[level].load();
+            if (Marked(node_next))
+            {
+              break; // node is being removed
+            }
+            if (Pointer(node_next) != successors[level] && (!node->Next()[level].compare_exchange_strong(node_next, reinterpret_cast<uintptr_t>(successors[level]))))
+            {
+              continue;
+            }
+            uintptr_t expected = reinterpret_cast<uintptr_t>(successors[level]);
+            linked = predecessors[level]->Next()[level].compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(node));
+            if (!linked)
+            {
+              Find(element, predecessors, successors);
+            }
+          }
+          if (!linked)
+          {
+            break;
+          }
+        }
+
+        // If node was removed concurrently, make sure it is not linked in any level before releasing it
+        if (Marked(node->Next()[0].load()))
+        {
+          Find(element, predecessors, successors);
+        }
+        retired_node = Release(node);
+      }
+      if (retired_node)
+      {
+        ReclaimRetiredNodes();
+      }
+      return tHandle(element);
+    }
+
+    template <typename TIterator>
+    void AddRange(TIterator begin, TIterator end)
+    {
+      for (; begin != end; ++begin)
+      {
+        if (*begin != TNullElement::cNULL_ELEMENT)
+        {
+          Add(*begin);
+        }
+      }
+    }
+
+    tConstIterator Begin() const
+    {
+      tConstIterator result(*this);
+      result.SetNode(FirstNode(head, 0));
+      return result;
+    }
+
+    void Clear()
+    {
+      for (tConstIterator it = Begin(); it != End(); ++it)
+      {
+        Remove(it.current_element);
+      }
+    }
+
+    bool Contains(const T& element) const
+    {
+      tGracePeriods::tReadSection read_section(grace_periods);
+      tNode* node = FindLowerBound(element);
+      return node && (!compare(element, node->element));
+    }
+
+    bool Empty() const
+    {
+      return Begin() == End();
+    }
+
+    tConstIterator End() const
+    {
+      return tConstIterator();
+    }
+
+    tConstIterator LowerBound(const T& element) const
+    {
+      tConstIterator result(*this);
+      result.SetNode(FindLowerBound(element));
+      return result;
+    }
+
+    tConstIterator Remove(tConstIterator position)
+    {
+      Remove(position.current_element);
+      ++position;
+      return position;
+    }
+
+    void Remove(const tHandle& handle)
+    {
+      if (handle.element != TNullElement::cNULL_ELEMENT)
+      {
+        Remove(handle.element);
+      }
+    }
+
+    void Remove(const T& element)
+    {
+      bool retired_node = false;
+      {
+        tGracePeriods::tReadSection read_section(grace_periods);
+        tNode* predecessors[MAX_LEVEL];
+        tNode* successors[MAX_LEVEL];
+        if (!Find(element, predecessors, successors))
+        {
+          return;
+        }
+
+        // Mark upper levels, then level 0 (whoever marks level 0 removes the element)
+        tNode* node = successors[0];
+        for (size_t level = node->height - 1; level > 0; level--)
+        {
+          uintptr_t next = node->Next()[level].load();
+          while (!Marked(next) && (!node->Next()[level].compare_exchange_weak(next, next | 1)));
+        }
+        uintptr_t next = node->Next()[0].load();
+        while (true)
+        {
+          if (Marked(next))
+          {
+            return; // removed by another thread
+          }
+          if (node->Next()[0].compare_exchange_strong(next, next | 1))
+          {
+            break;
+          }
+        }
+        Find(element, predecessors, successors);  // unlinks node
+        retired_node = Release(node);
+      }
+      if (retired_node)
+      {
+        ReclaimRetiredNodes();
+      }
+    }
+
+    template <typename TIterator>
+    void RemoveAll(TIterator begin, TIterator end)
+    {
+      for (; begin != end; ++begin)
+      {
+        Remove(*begin);
+      }
+    }
+
+    template <typename TPredicate>
+    void RemoveIf(TPredicate predicate)
+    {
+      for (tConstIterator it = Begin(); it != End(); ++it)
+      {
+        if (predicate(it.current_element))
+        {
+          Remove(it.current_element);
+        }
+      }
+    }
+
+    /*!
+     * External iterator (for use by users of set) - excludes removed elements
+     * (while an iterator exists, the nodes it might visit are not deleted)
+     */
+    class tConstIterator : private tGracePeriods::tReadSection, public std::iterator<std::input_iterator_tag, typename IteratorCustomization<T, DEREFERENCING_ITERATOR>::tReturnType, size_t>
+    {
+      typedef std::iterator<std::input_iterator_tag, typename IteratorCustomization<T, DEREFERENCING_ITERATOR>::tReturnType, size_t> tBase;
+
+    public:
+
+      tConstIterator() :
+        current_node(NULL),
+        current_element(TNullElement::cNULL_ELEMENT)
+      {}
+
+      // Operators needed for C++ Input Iterator
+
+      template <bool DEREF = DEREFERENCING_ITERATOR>
+      inline typename std::enable_if < !DEREF, typename tBase::reference >::type operator*() const
+      {
+        assert(current_node);
+        return current_element;
+      }
+      template <bool DEREF = DEREFERENCING_ITERATOR>
+      inline typename std::enable_if<DEREF, typename tBase::reference>::type operator*() const
+      {
+        assert(current_node);
+        return *current_element;
+      }
+      inline typename tBase::pointer operator->() const
+      {
+        return &(operator*());
+      }
+
+      inline tConstIterator& operator++()
+      {
+        SetNode(FirstNode(current_node, 0));
+        return *this;
+      }
+      inline tConstIterator operator ++ (int)
+      {
+        tConstIterator temp(*this);
+        operator++();
+        return temp;
+      }
+
+      inline const bool operator == (const tConstIterator &other) const
+      {
+        return current_node == other.current_node;
+      }
+      inline const bool operator != (const tConstIterator &other) const
+      {
+        return !(*this == other);
+      }
+
+    private:
+
+      friend class tInstance;
+
+      /*! Enters read section - node is set afterwards */
+      explicit tConstIterator(const tInstance& instance) :
+        tGracePeriods::tReadSection(instance.grace_periods),
+        current_node(NULL),
+        current_element(TNullElement::cNULL_ELEMENT)
+      {}
+
+      void SetNode(tNode* node)
+      {
+        current_node = node;
+        current_element = node ? node->element : static_cast<T>(TNullElement::cNULL_ELEMENT);
+      }
+
+      /*! Current node (NULL for end iterator) */
+      tNode* current_node;
+
+      /*! Element in current node */
+      T current_element;
+    };
+
+    //----------------------------------------------------------------------
+    // Private fields and methods
+    //----------------------------------------------------------------------
+  private:
+
+    struct tNode
+    {
+      tNode(const T& element, size_t height) :
+        element(element),
+        height(height),
+        owners(2),
+        retire_epoch(0),
+        next_retired(NULL)
+      {
+        for (size_t i = 0; i < height; i++)
+        {
+          new(&Next()[i]) std::atomic<uintptr_t>(0);
+        }
+      }
+
+      /*!
+       * \return Next pointers of this node's levels (lowest bit marks node as removed)
+       */
+      std::atomic<uintptr_t>* Next()
+      {
+        return reinterpret_cast<std::atomic<uintptr_t>*>(this + 1);
+      }
+
+      /*! Element stored in node */
+      const T element;
+
+      /*! Number of levels that node is (or will be) linked in */
+      const size_t height;
+
+      /*!
+       * Threads that still need the node (adding thread and removing thread).
+       * When both have released it, it is unlinked from all levels and can be retired.
+       */
+      std::atomic<int> owners;
+
+      /*! Epoch in which node was retired */
+      size_t retire_epoch;
+
+      /*! Next node in stack of retired nodes */
+      tNode* next_retired;
+    };
+
+    static_assert(sizeof(tNode) % alignof(std::atomic<uintptr_t>) == 0, "Next pointers must be aligned");
+
+    /*! Head node (with maximum height - its element is not used) */
+    tNode* const head;
+
+    /*! Grace periods for deferred deletion of unlinked nodes */
+    tGracePeriods grace_periods;
+
+    /*! Stack of retired nodes that have not been deleted yet */
+    std::atomic<tNode*> retired;
+
+    /*! Comparator */
+    TCompare<T> compare;
+
+
+    static tNode* CreateNode(const T& element, size_t height)
+    {
+      void* memory = ::operator new(sizeof(tNode) + height * sizeof(std::atomic<uintptr_t>));
+      return new(memory) tNode(element, height);
+    }
+
+    static void DeleteNode(tNode* node)
+    {
+      node->~tNode();
+      ::operator delete(node);
+    }
+
+    static void DeleteNodes(tNode* stack)
+    {
+      while (stack)
+      {
+        tNode* next = stack->next_retired;
+        DeleteNode(stack);
+        stack = next;
+      }
+    }
+
+    /*!
+     * Finds predecessors and successors of element in all levels.
+     * Unlinks any marked nodes on the way.
+     *
+     * \param element Element to look for
+     * \param predecessors Array to store last node with smaller element in each level
+     * \param successors Array to store first node with element that is not smaller in each level (NULL if there is none)
+     * \return True if element is in set (successors[0] contains element then)
+     */
+    bool Find(const T& element, tNode** predecessors, tNode** successors)
+    {
+      while (true)
+      {
+        bool retry = false;
+        tNode* predecessor = head;
+        for (size_t level = MAX_LEVEL; level-- > 0 && (!retry);)
+        {
+          tNode* current = Pointer(predecessor->Next()[level].load());
+          while (current)
+          {
+            uintptr_t successor = current->Next()[level].load();
+            if (Marked(successor))
+            {
+              // Unlink marked node
+              uintptr_t expected = reinterpret_cast<uintptr_t>(current);
+              if (!predecessor->Next()[level].compare_exchange_strong(expected, successor & ~static_cast<uintptr_t>(1)))
+              {
+                retry = true;
+                break;
+              }
+              current = Pointer(successor);
+            }
+            else if (compare(current->element, element))
+            {
+              predecessor = current;
+              current = Pointer(successor);
+            }
+            else
+            {
+              break;
+            }
+          }
+          predecessors[level] = predecessor;
+          successors[level] = current;
+        }
+        if (!retry)
+        {
+          return successors[0] && (!compare(element, successors[0]->element));
+        }
+      }
+    }
+
+    /*!
+     * \return First node in level 0 with an element that is not smaller than the specified one (NULL if there is none). Does not modify list.
+     */
+    tNode* FindLowerBound(const T& element) const
+    {
+      tNode* predecessor = head;
+      tNode* current = NULL;
+      for (size_t level = MAX_LEVEL; level-- > 0;)
+      {
+        current = Pointer(predecessor->Next()[level].load());
+        while (current)
+        {
+          uintptr_t successor = current->Next()[level].load();
+          if (Marked(successor))
+          {
+            current = Pointer(successor);
+          }
+          else if (compare(current->element, element))
+          {
+            predecessor = current;
+            current = Pointer(successor);
+          }
+          else
+          {
+            break;
+          }
+        }
+      }
+      return current;
+    }
+
+    /*!
+     * \return First node after the specified one in the specified level that is not marked (NULL if there is none)
+     */
+    static tNode* FirstNode(tNode* node, size_t level)
+    {
+      tNode* current = Pointer(node->Next()[level].load());
+      while (current && Marked(current->Next()[level].load()))
+      {
+        current = Pointer(current->Next()[level].load());
+      }
+      return current;
+    }
+
+    static bool Marked(uintptr_t next)
+    {
+      return next & 1;
+    }
+
+    static tNode* Pointer(uintptr_t next)
+    {
+      return reinterpret_cast<tNode*>(next & ~static_cast<uintptr_t>(1));
+    }
+
+    /*!
+     * \return Random node height (1 with probability 1/2, 2 with probability 1/4, ...)
+     */
+    static size_t RandomHeight()
+    {
+      static thread_local uint64_t state = std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      return __builtin_ctzll(state | (static_cast<uint64_t>(1) << (MAX_LEVEL - 1))) + 1;
+    }
+
+    /*!
+     * Deletes retired nodes that no read section can access anymore (if the epoch can be advanced)
+     */
+    void ReclaimRetiredNodes()
+    {
+      if (!grace_periods.TryAdvance())
+      {
+        return;
+      }
+      size_t epoch = grace_periods.GetEpoch();
+      tNode* stack = retired.exchange(NULL);
+      tNode* keep_first = NULL;
+      tNode* keep_last = NULL;
+      while (stack)
+      {
+        tNode* next = stack->next_retired;
+        if (stack->retire_epoch + 2 <= epoch)
+        {
+          DeleteNode(stack);
+        }
+        else
+        {
+          stack->next_retired = keep_first;
+          keep_first = stack;
+          keep_last = keep_last ? keep_last : stack;
+        }
+        stack = next;
+      }
+      if (keep_first)
+      {
+        keep_last->next_retired = retired.load();
+        while (!retired.compare_exchange_weak(keep_last->next_retired, keep_first));
+      }
+    }
+
+    /*!
+     * Releases node (called by adding and removing thread after node is linked or unlinked respectively).
+     * The node is retired when both have released it.
+     *
+     * \return True if node was retired
+     */
+    bool Release(tNode* node)
+    {
+      if (--node->owners != 0)
+      {
+        return false;
+      }
+      node->retire_epoch = grace_periods.GetEpoch();
+      node->next_retired = retired.load();
+      while (!retired.compare_exchange_weak(node->next_retired, node));
+      return true;
+    }
+  };
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+}
+
+
+#endif
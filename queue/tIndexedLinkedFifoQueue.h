@@ -0,0 +1,306 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/queue/tIndexedLinkedFifoQueue.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tIndexedLinkedFifoQueue
+ *
+ * \b tIndexedLinkedFifoQueue
+ *
+ * Concurrent intrusive queue implementation for elements linked via 32-bit indices
+ * (elements derived from tQueueable<tQueueability::INDEXED>).
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__concurrent_containers__queue__tIndexedLinkedFifoQueue_h__
+#define __rrlib__concurrent_containers__queue__tIndexedLinkedFifoQueue_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tNoncopyable.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tQueueable.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+namespace queue
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Concurrent intrusive queue with 32-bit index links
+/*!
+ * Queue implementation for elements derived from tQueueable<tQueueability::INDEXED>
+ * that are allocated from a tIndexedArena (D::tArena).
+ *
+ * Same algorithm as the non-'FAST' linked queues (with fill element, so that all elements can be dequeued).
+ * First and last element are stored as 32-bit index and 32-bit stamp in a single 64-bit word.
+ * The queue's own fill element has the reserved index cFILL_INDEX.
+ *
+ * In bounded queues, stamps count enqueued and dequeued elements. As they have 32 bits,
+ * maximum lengths up to 2^31 - 1 are possible and stamp wraparound has no effect.
+ */
+template <typename T, typename D, tConcurrency CONCURRENCY, tDequeueMode DEQUEUE_MODE, bool BOUNDED>
+class tIndexedLinkedFifoQueue : private rrlib::util::tNoncopyable
+{
+  static_assert(DEQUEUE_MODE != tDequeueMode::ALL, "Elements with tQueueability::INDEXED cannot be used in queues with tDequeueMode::ALL");
+
+  typedef typename D::tArena tArena;
+
+  /*! Index of this queue's fill element */
+  enum { cFILL_INDEX = 0xFFFFFFFEu };
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef std::unique_ptr<T, D> tPointer;
+  enum { cMINIMUM_ELEMENTS_IN_QEUEUE = 0 };
+
+  tIndexedLinkedFifoQueue() :
+    max_length(500000),
+    fill_element(),
+    fill_element_enqueued(true),
+    first(Pack(cFILL_INDEX, 0)),
+    last(Pack(cFILL_INDEX, 0)),
+    threads_enqueuing(0)
+  {
+  }
+
+  inline tPointer Dequeue()
+  {
+    uint64_t result = first.load();
+    while (true)
+    {
+      uint32_t result_index = Index(result);
+      uint32_t nextnext = Link(result_index)->next_index;
+      if (nextnext == tQueueableIndexed::cNULL_INDEX)
+      {
+        // last element in queue... enqueue fill element?
+        if (result_index != cFILL_INDEX && fill_element_enqueued.exchange(true) == false)
+        {
+          EnqueueIndex(cFILL_INDEX);
+          // so... now we might be able to dequeue the other element
+          nextnext = Link(result_index)->next_index;
+        }
+        if (nextnext == tQueueableIndexed::cNULL_INDEX)
+        {
+          return tPointer();
+        }
+      }
+      uint64_t new_first = Pack(nextnext, Stamp(result) + 1);
+      if (first.compare_exchange_strong(result, new_first))
+      {
+        Link(result_index)->next_index = tQueueableIndexed::cNULL_INDEX;
+        if (result_index != cFILL_INDEX)
+        {
+          return tPointer(tArena::Element(result_index));
+        }
+        fill_element_enqueued = false;
+        result = new_first;
+      }
+    }
+  }
+
+  inline void Enqueue(tPointer && element)
+  {
+    EnqueueIndex(tArena::GetIndex(element.get()));
+    element.release();
+  }
+
+  int GetMaxLength() const
+  {
+    return max_length;
+  }
+
+  void SetMaxLength(int max_length)
+  {
+    if (max_length <= 0)
+    {
+      RRLIB_LOG_PRINT(ERROR, "Invalid queue length: ", max_length, ". Ignoring.");
+      return;
+    }
+    int old_length = this->max_length.exchange(max_length);
+    if (max_length < old_length)
+    {
+      TryDequeueingElementsOverBounds(Stamp(last.load()), max_length, old_length - max_length);
+    }
+  }
+
+  /*!
+   * \return Number of elements in queue (only exact if there are no concurrent operations)
+   */
+  int Size() const
+  {
+    static_assert(BOUNDED, "Enqueued elements are only counted in bounded queues");
+    return static_cast<int>(Stamp(last.load()) - Stamp(first.load())) + (fill_element_enqueued ? 0 : 1);
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Maximum queue length (bounded queues only) */
+  std::atomic<int> max_length;
+
+  /*! Dummy fill element to be able to dequeue all elements */
+  tQueueableIndexed fill_element;
+
+  /*! True, if fill element is currently enqueued */
+  std::atomic<bool> fill_element_enqueued;
+
+  /*!
+   * First element in queue (index in lower 32 bits).
+   * Stamp counts number of dequeued elements.
+   */
+  std::atomic<uint64_t> first;
+
+  /*!
+   * Last element in queue (index in lower 32 bits).
+   * In bounded queues, stamp counts number of enqueued elements.
+   */
+  std::atomic<uint64_t> last;
+
+  /*! Threads currently enqueueing elements (bounded queues only) */
+  std::atomic<int> threads_enqueuing;
+
+  inline void EnqueueIndex(uint32_t index)
+  {
+    if (!BOUNDED)
+    {
+      uint64_t prev = last.exchange(Pack(index, 0));
+      assert(Index(prev) != index);
+      Link(Index(prev))->next_index = index;
+      return;
+    }
+
+    threads_enqueuing++;
+    uint64_t prev = last.load();
+    while (!last.compare_exchange_weak(prev, Pack(index, Stamp(prev) + 1)))
+    {}
+    assert(Index(prev) != index);
+    Link(Index(prev))->next_index = index;
+
+    // dequeue some elements? (only if all threads completed setting 'next' up to current stamp)
+    if (--threads_enqueuing == 0 && index != cFILL_INDEX)
+    {
+      TryDequeueingElementsOverBounds(Stamp(prev) + 1, max_length, 10);
+    }
+  }
+
+  inline tQueueableIndexed* Link(uint32_t index)
+  {
+    return index == cFILL_INDEX ? &fill_element : static_cast<tQueueableIndexed*>(tArena::Element(index));
+  }
+
+  /*!
+   * Attempt to dequeue elements that exceed max length
+   * If another threads interferes - abort attempt
+   */
+  void TryDequeueingElementsOverBounds(uint32_t last_stamp, int max_length, int max_elements_to_dequeue)
+  {
+    uint64_t first_element = first.load();
+    int dequeued = 0;
+    while (dequeued < max_elements_to_dequeue)
+    {
+      uint32_t length = last_stamp - Stamp(first_element);
+      if (length >= 0x80000000u || length < static_cast<uint32_t>(max_length))
+      {
+        // (length >= 2^31: other threads already dequeued elements enqueued after 'last_stamp')
+        return;
+      }
+
+      // dequeue one element
+      uint32_t first_index = Index(first_element);
+      uint32_t nextnext = Link(first_index)->next_index;
+      if (nextnext == tQueueableIndexed::cNULL_INDEX)
+      {
+        return;
+      }
+      uint64_t new_first = Pack(nextnext, Stamp(first_element) + 1);
+      if (!first.compare_exchange_strong(first_element, new_first))
+      {
+        // another thread interfered
+        return;
+      }
+      Link(first_index)->next_index = tQueueableIndexed::cNULL_INDEX;
+      if (first_index != cFILL_INDEX)
+      {
+        // discard element
+        tPointer ptr(tArena::Element(first_index));
+      }
+      else
+      {
+        fill_element_enqueued = false;
+      }
+      first_element = new_first;
+      dequeued++;
+    }
+  }
+
+  static uint32_t Index(uint64_t packed)
+  {
+    return static_cast<uint32_t>(packed);
+  }
+
+  static uint32_t Stamp(uint64_t packed)
+  {
+    return static_cast<uint32_t>(packed >> 32);
+  }
+
+  static uint64_t Pack(uint32_t index, uint32_t stamp)
+  {
+    return (static_cast<uint64_t>(stamp) << 32) | index;
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
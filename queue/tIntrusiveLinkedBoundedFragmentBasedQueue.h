@@ -0,0 +1,212 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/queue/tIntrusiveLinkedBoundedFragmentBasedQueue.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tIntrusiveLinkedBoundedFragmentBasedQueue
+ *
+ * \b tIntrusiveLinkedBoundedFragmentBasedQueue
+ *
+ * Concurrent bounded intrusive linked queue for tDequeueMode::ALL
+ * that only requires elements derived from tQueueableMost (blocking - opt-in via tAllowBlockingBoundedFragmentQueue).
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__concurrent_containers__queue__tIntrusiveLinkedBoundedFragmentBasedQueue_h__
+#define __rrlib__concurrent_containers__queue__tIntrusiveLinkedBoundedFragmentBasedQueue_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tAdaptiveMutex.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+namespace queue
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Bounded fragment-based queue for tQueueableMost
+/*!
+ * Concurrent bounded intrusive linked queue for tDequeueMode::ALL.
+ *
+ * Like the tQueueableFull implementation in tIntrusiveLinkedFragmentBasedQueue, elements are
+ * stored in a LIFO chain that is split into chunks of (up to) 'max_length' elements.
+ * When a new chunk is started, the chunk before the previous one is deleted - so the queue
+ * contains at most twice 'max_length' elements. DequeueAll() returns the newest 'max_length' elements.
+ *
+ * Instead of storing chunk information in every element (tQueueableFull's second pointer),
+ * the heads (oldest elements) of the current and the previous chunk are tracked in a small
+ * ring in this queue. As this side storage and 'last' cannot be updated with a single
+ * compare-and-swap operation, Enqueue() and DequeueAll() hold a tAdaptiveMutex for a few
+ * instructions. Deleting obsolete chunks is done after releasing the mutex.
+ * As tAdaptiveMutex suspends threads that do not acquire it after spinning briefly, this queue is blocking.
+ * It is therefore only used for types T that opt in by specializing tAllowBlockingBoundedFragmentQueue<T>.
+ * Elements derived from tQueueableFull use the lock-free implementation instead.
+ */
+template <typename T, typename D, tConcurrency CONCURRENCY>
+class tIntrusiveLinkedBoundedFragmentBasedQueue : private rrlib::util::tNoncopyable
+{
+  static_assert(tAllowBlockingBoundedFragmentQueue<T>::value, "This queue is blocking. Specialize tAllowBlockingBoundedFragmentQueue<T> to use it - or derive T from tQueueable<FULL> or tQueueable<FULL_OPTIMIZED>.");
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef std::unique_ptr<T, D> tPointer;
+  enum { cMINIMUM_ELEMENTS_IN_QEUEUE = 0 };
+
+  tIntrusiveLinkedBoundedFragmentBasedQueue() :
+    mutex(),
+    last(NULL),
+    chunk_heads(),
+    current_chunk(0),
+    current_chunk_length(0),
+    max_length(500000)
+  {}
+
+  inline tQueueFragment<tPointer> DequeueAll()
+  {
+    queue::tQueueFragmentImplementation<tPointer> result;
+    tQueueableMost* ex_last = NULL;
+    {
+      tAdaptiveMutex::tLock lock(mutex);
+      ex_last = last;
+      last = NULL;
+      chunk_heads[0] = NULL;
+      chunk_heads[1] = NULL;
+      current_chunk_length = 0;
+    }
+
+    // chain contains current and previous chunk only (older chunks are cut off in Enqueue())
+    result.InitLIFO(ex_last, max_length);
+    return std::move(result);
+  }
+
+  inline void Enqueue(tPointer && element)
+  {
+    uint max_len = max_length;
+    tQueueableMost* chunk_to_delete = NULL;
+    {
+      tAdaptiveMutex::tLock lock(mutex);
+      assert(last != element.get());
+      if (!last)
+      {
+        chunk_heads[current_chunk] = element.get();
+        chunk_heads[current_chunk ^ 1] = NULL;
+        current_chunk_length = 1;
+      }
+      else if (current_chunk_length >= max_len)
+      {
+        // start new chunk: cut off previous chunk (head of previous chunk is not linked to older elements)
+        tQueueableMost* current_head = chunk_heads[current_chunk];
+        chunk_to_delete = current_head->next_queueable;
+        current_head->next_queueable = NULL;
+        current_chunk ^= 1;
+        chunk_heads[current_chunk] = element.get();
+        current_chunk_length = 1;
+      }
+      else
+      {
+        current_chunk_length++;
+      }
+      element->next_queueable = last;
+      last = element.release();
+    }
+
+    // delete obsolete chunk
+    while (chunk_to_delete)
+    {
+      tQueueableMost* temp = chunk_to_delete;
+      chunk_to_delete = chunk_to_delete->next_queueable;
+      temp->next_queueable = NULL;
+      tPointer p(static_cast<T*>(temp));
+    }
+  }
+
+  int GetMaxLength() const
+  {
+    return this->max_length;
+  }
+
+  void SetMaxLength(int max_length)
+  {
+    if (max_length <= 0 || max_length > 500000)
+    {
+      RRLIB_LOG_PRINT(ERROR, "Invalid queue length: ", max_length, ". Ignoring.");
+      return;
+    }
+    this->max_length = max_length;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Mutex for 'last' and side storage */
+  tAdaptiveMutex mutex;
+
+  /*! Last element in queue */
+  tQueueableMost* last;
+
+  /*! Ring with first (oldest) elements of current and previous chunk */
+  tQueueableMost* chunk_heads[2];
+
+  /*! Index of current chunk in 'chunk_heads' */
+  uint current_chunk;
+
+  /*! Number of elements in current chunk */
+  uint current_chunk_length;
+
+  /*! 'Maximum length' of queue (fragments) */
+  std::atomic<int> max_length;
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
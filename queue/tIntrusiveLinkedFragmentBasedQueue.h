@@ -128,7 +128,7 @@ private:
 template <typename T, typename D, tConcurrency CONCURRENCY>
 class tIntrusiveLinkedFragmentBasedQueue<T, D, CONCURRENCY, true> : private rrlib::util::tNoncopyable
 {
-  static_assert(std::is_base_of<tQueueableFull, T>::value, "T needs to be derived from tQueueable<FULL> or tQueueable<FULL_OPTIMIZED> for this kind of queue.");
+  static_assert(std::is_base_of<tQueueableFull, T>::value, "T needs to be derived from tQueueable<FULL> or tQueueable<FULL_OPTIMIZED> for this kind of queue (or specialize tAllowBlockingBoundedFragmentQueue<T> to use a blocking queue).");
 
 //----------------------------------------------------------------------
 // Public methods and typedefs
@@ -263,7 +263,7 @@ private:
 template <typename T, typename D, tConcurrency CONCURRENCY>
 class tIntrusiveLinkedFragmentBasedQueue<T, D, CONCURRENCY, true> : private rrlib::util::tNoncopyable
 {
-  static_assert(std::is_base_of<tQueueableFull, T>::value, "T needs to be derived from tQueueable<FULL> or tQueueable<FULL_OPTIMIZED> for this kind of queue.");
+  static_assert(std::is_base_of<tQueueableFull, T>::value, "T needs to be derived from tQueueable<FULL> or tQueueable<FULL_OPTIMIZED> for this kind of queue (or specialize tAllowBlockingBoundedFragmentQueue<T> to use a blocking queue).");
 
 //----------------------------------------------------------------------
 // Public methods and typedefs
@@ -107,6 +107,16 @@ public:
     assert((!to_delete) && (!next_queueable));
   }
 
+  /*!
+   * Drops all elements without unlinking them
+   * (for fragments with non-owning pointers - links are reset when elements are enqueued again)
+   */
+  void Abandon()
+  {
+    next_queueable = NULL;
+    to_delete = NULL;
+  }
+
   template <typename T, typename D>
   void DeleteObsoleteElements()
   {
@@ -234,6 +244,15 @@ public:
     return *this;
   }
 
+  /*!
+   * Drops all elements without unlinking them
+   * (for fragments with non-owning pointers - links are reset when elements are enqueued again)
+   */
+  void Abandon()
+  {
+    next_queueable_single_threaded = NULL;
+  }
+
   template <typename T, typename D>
   void DeleteObsoleteElements() {}
 
@@ -374,6 +393,12 @@ public:
     return *this;
   }
 
+  void Abandon()
+  {
+    tIntrusiveQueueFragmentQueueable::Abandon();
+    tIntrusiveQueueFragmentQueueableSingleThreaded::Abandon();
+  }
+
   template <typename TP, typename D>
   void DeleteObsoleteElements()
   {
@@ -0,0 +1,158 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/queue/tNodeQueue.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tNodeQueue
+ *
+ * \b tNodeQueue
+ *
+ * Queue implementation for unique pointers to types that are not derived from tQueueable.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__concurrent_containers__queue__tNodeQueue_h__
+#define __rrlib__concurrent_containers__queue__tNodeQueue_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/queue/tQueueNode.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+namespace queue
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+template <typename T, typename D, tConcurrency CONCURRENCY, tDequeueMode DEQUEUE_MODE, bool BOUNDED, bool QUEUEABLE_TYPE>
+class tUniquePtrQueueImplementation;
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Node-based queue
+/*!
+ * Queue implementation for unique pointers to types that are not derived from tQueueable
+ * (e.g. third-party types).
+ *
+ * Elements are wrapped in queueable link nodes (tQueueNode) which are enqueued in the
+ * intrusive queue implementation with the same parameters. Nodes are taken from a lock-free,
+ * per-queue pool (tQueueNodePool) - so enqueueing does not allocate memory in steady state.
+ */
+template <typename T, typename D, tConcurrency CONCURRENCY, tDequeueMode DEQUEUE_MODE, bool BOUNDED>
+class tNodeQueue : private rrlib::util::tNoncopyable
+{
+  typedef tQueueNode<T, D> tNode;
+  typedef std::unique_ptr<tNode, tQueueNodeDeleter<T, D>> tNodePointer;
+  typedef tUniquePtrQueueImplementation<tNode, tQueueNodeDeleter<T, D>, CONCURRENCY, DEQUEUE_MODE, BOUNDED, true> tNodeQueueImplementation;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef std::unique_ptr<T, D> tPointer;
+  enum { cMINIMUM_ELEMENTS_IN_QEUEUE = tNodeQueueImplementation::cMINIMUM_ELEMENTS_IN_QEUEUE };
+
+  tNodeQueue() : pool(), nodes() {}
+
+  inline tPointer Dequeue()
+  {
+    return tQueueFragmentImplementation<tPointer>::Unwrap(nodes.Dequeue());
+  }
+
+  inline tQueueFragment<tPointer> DequeueAll()
+  {
+    return tQueueFragment<tPointer>(tQueueFragmentImplementation<tPointer>(nodes.DequeueAll()));
+  }
+
+  inline void Enqueue(tPointer && element)
+  {
+    assert(element);
+    tNode* node = pool.pool->GetNode();
+    node->element = element.release();
+    nodes.Enqueue(tNodePointer(node));
+  }
+
+  int GetMaxLength() const
+  {
+    return nodes.GetMaxLength();
+  }
+
+  void SetMaxLength(int max_length)
+  {
+    nodes.SetMaxLength(max_length);
+  }
+
+  int Size()
+  {
+    return nodes.Size();
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Holds queue's reference to pool (declared before 'nodes', so that it is released after nodes in queue are deleted) */
+  struct tPoolReference
+  {
+    tPoolReference() : pool(new tQueueNodePool<T, D>()) {}
+    ~tPoolReference()
+    {
+      pool->RemoveQueueReference();
+    }
+
+    tQueueNodePool<T, D>* pool;
+  };
+
+  /*! Pool of nodes */
+  tPoolReference pool;
+
+  /*! Queue with nodes */
+  tNodeQueueImplementation nodes;
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -43,7 +43,9 @@
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tQueueableSharedPointer.h"
 #include "rrlib/concurrent_containers/queue/tIntrusiveQueueFragment.h"
+#include "rrlib/concurrent_containers/queue/tQueueNode.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -52,6 +54,9 @@ namespace rrlib
 {
 namespace concurrent_containers
 {
+template <typename T>
+class tQueueFragment;
+
 namespace queue
 {
 
@@ -59,6 +64,31 @@ namespace queue
 // Forward declarations / typedefs / enums
 //----------------------------------------------------------------------
 
+/*!
+ * Deleter that does not delete anything.
+ * Raw pointer queues (tQueue<U*, ...>) use the unique pointer queue implementations with this deleter.
+ */
+struct tNonOwningDeleter
+{
+  void operator()(const void*) const {}
+};
+
+/*!
+ * Are elements of type T enqueued using queue nodes (tQueueNode)?
+ * (true for unique pointers to types that are not derived from tQueueable)
+ */
+template <typename T>
+struct tIsNodeQueueElement
+{
+  enum { value = false };
+};
+
+template <typename T, typename D>
+struct tIsNodeQueueElement<std::unique_ptr<T, D>>
+{
+  enum { value = !(std::is_base_of<tQueueableMost, T>::value || std::is_base_of<tQueueableSingleThreaded, T>::value) };
+};
+
 //----------------------------------------------------------------------
 // Class declaration
 //----------------------------------------------------------------------
@@ -66,14 +96,14 @@ namespace queue
 /*!
  * Implementation of queue fragment for different types.
  */
-template <typename T>
+template <typename T, bool NODE_BASED = tIsNodeQueueElement<T>::value>
 class tQueueFragmentImplementation
 {
   // this type T is not supported yet
 };
 
 template <typename T, typename D>
-class tQueueFragmentImplementation<std::unique_ptr<T, D>> :
+class tQueueFragmentImplementation<std::unique_ptr<T, D>, false> :
       public tIntrusiveQueueFragment<T, std::is_base_of<tQueueableMost, T>::value, std::is_base_of<tQueueableSingleThreaded, T>::value>
 {
 public:
@@ -90,6 +120,11 @@ public:
 
   ~tQueueFragmentImplementation()
   {
+    if (std::is_same<D, tNonOwningDeleter>::value)
+    {
+      tBase::Abandon(); // elements are managed externally
+      return;
+    }
     tBase::template DeleteObsoleteElements<T, D>();
     while (!this->Empty())
     {
@@ -113,6 +148,155 @@ public:
   }
 };
 
+/*!
+ * Fragment of node-based queue (tNodeQueue): wraps fragment with queue nodes
+ */
+template <typename T, typename D>
+class tQueueFragmentImplementation<std::unique_ptr<T, D>, true> : private rrlib::util::tNoncopyable
+{
+  typedef std::unique_ptr<tQueueNode<T, D>, tQueueNodeDeleter<T, D>> tNodePointer;
+
+public:
+  typedef std::unique_ptr<T, D> tPointer;
+
+  tQueueFragmentImplementation() {}
+  tQueueFragmentImplementation(tQueueFragment<tNodePointer> && nodes) : nodes(std::move(nodes)) {}
+  tQueueFragmentImplementation(tQueueFragmentImplementation && other) : nodes(std::move(other.nodes)) {}
+  tQueueFragmentImplementation& operator=(tQueueFragmentImplementation && other)
+  {
+    std::swap(nodes, other.nodes);
+    return *this;
+  }
+
+  bool Empty()
+  {
+    return nodes.Empty();
+  }
+
+  tPointer PopAny()
+  {
+    return Unwrap(nodes.PopAny());
+  }
+
+  tPointer PopBack()
+  {
+    return Unwrap(nodes.PopBack());
+  }
+
+  tPointer PopFront()
+  {
+    return Unwrap(nodes.PopFront());
+  }
+
+  /*!
+   * Moves element out of node (node is returned to its pool)
+   */
+  static tPointer Unwrap(tNodePointer && node)
+  {
+    if (!node)
+    {
+      return tPointer();
+    }
+    tPointer result(node->element);
+    node->element = NULL;
+    return result;
+  }
+
+private:
+
+  /*! Fragment with queue nodes (remaining elements are deleted with their nodes) */
+  tQueueFragment<tNodePointer> nodes;
+};
+
+/*!
+ * Fragment of queue with shared pointers: wraps fragment with queue references
+ */
+template <typename T, size_t SLOT>
+class tQueueFragmentImplementation<tQueueableSharedPointer<T, SLOT>, false> : private rrlib::util::tNoncopyable
+{
+  typedef typename tQueueableSharedPointer<T, SLOT>::tQueueReference tQueueReference;
+
+public:
+  typedef tQueueableSharedPointer<T, SLOT> tPointer;
+
+  tQueueFragmentImplementation() {}
+  tQueueFragmentImplementation(tQueueFragment<tQueueReference> && references) : references(std::move(references)) {}
+  tQueueFragmentImplementation(tQueueFragmentImplementation && other) : references(std::move(other.references)) {}
+  tQueueFragmentImplementation& operator=(tQueueFragmentImplementation && other)
+  {
+    std::swap(references, other.references);
+    return *this;
+  }
+
+  bool Empty()
+  {
+    return references.Empty();
+  }
+
+  tPointer PopAny()
+  {
+    return tPointer::FromQueueReference(references.PopAny());
+  }
+
+  tPointer PopBack()
+  {
+    return tPointer::FromQueueReference(references.PopBack());
+  }
+
+  tPointer PopFront()
+  {
+    return tPointer::FromQueueReference(references.PopFront());
+  }
+
+private:
+
+  /*! Fragment with queue references (remaining references are released with fragment) */
+  tQueueFragment<tQueueReference> references;
+};
+
+/*!
+ * Fragment of queue with raw pointers: wraps fragment with non-owning unique pointers
+ */
+template <typename T>
+class tQueueFragmentImplementation<T*, false> : private rrlib::util::tNoncopyable
+{
+  typedef std::unique_ptr<T, tNonOwningDeleter> tNonOwningPointer;
+
+public:
+  tQueueFragmentImplementation() {}
+  tQueueFragmentImplementation(tQueueFragment<tNonOwningPointer> && elements) : elements(std::move(elements)) {}
+  tQueueFragmentImplementation(tQueueFragmentImplementation && other) : elements(std::move(other.elements)) {}
+  tQueueFragmentImplementation& operator=(tQueueFragmentImplementation && other)
+  {
+    std::swap(elements, other.elements);
+    return *this;
+  }
+
+  bool Empty()
+  {
+    return elements.Empty();
+  }
+
+  T* PopAny()
+  {
+    return elements.PopAny().release();
+  }
+
+  T* PopBack()
+  {
+    return elements.PopBack().release();
+  }
+
+  T* PopFront()
+  {
+    return elements.PopFront().release();
+  }
+
+private:
+
+  /*! Fragment with elements (remaining elements are dropped with fragment) */
+  tQueueFragment<tNonOwningPointer> elements;
+};
 
 //----------------------------------------------------------------------
 // End of namespace declaration
@@ -44,8 +44,11 @@
 // Internal includes with ""
 //----------------------------------------------------------------------
 #include "rrlib/concurrent_containers/tQueueable.h"
+#include "rrlib/concurrent_containers/tQueueableSharedPointer.h"
 #include "rrlib/concurrent_containers/tQueueFragment.h"
 #include "rrlib/concurrent_containers/queue/tUniquePtrQueueImplementation.h"
+#include "rrlib/concurrent_containers/queue/tIndexedLinkedFifoQueue.h"
+#include "rrlib/concurrent_containers/queue/tSegmentedValueQueue.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -69,9 +72,11 @@ namespace queue
  * Implementations for different types of queues.
  */
 template <typename T, tConcurrency CONCURRENCY, tDequeueMode DEQUEUE_MODE, bool BOUNDED>
-class tQueueImplementation
+class tQueueImplementation : public tSegmentedValueQueue<T>
 {
-  // this combination of parameters is not supported yet
+  // values are stored inline - other combinations of parameters are not supported yet
+  static_assert(!BOUNDED, "Bounded queues are only available for unique pointers");
+  static_assert(DEQUEUE_MODE != tDequeueMode::ALL, "tDequeueMode::ALL is only available for unique pointers");
 };
 
 template <tDequeueMode DEQUEUE_MODE>
@@ -100,11 +105,23 @@ struct tUniquePtrQueueElementDeleter<tDequeueMode::ALL>
   }
 };
 
+/*!
+ * Selects implementation for unique pointer queues
+ * (elements linked via 32-bit indices have their own implementation - it needs the arena from D)
+ */
+template <typename T, typename D, tConcurrency CONCURRENCY, tDequeueMode DEQUEUE_MODE, bool BOUNDED>
+struct tUniquePtrQueueImplementationSelector
+{
+  typedef typename std::conditional < std::is_base_of<tQueueableIndexed, T>::value && (!std::is_same<D, tNonOwningDeleter>::value),
+          tIndexedLinkedFifoQueue<T, D, CONCURRENCY, DEQUEUE_MODE, BOUNDED>,
+          tUniquePtrQueueImplementation<T, D, CONCURRENCY, DEQUEUE_MODE, BOUNDED, std::is_base_of<tQueueableMost, T>::value> >::type type;
+};
+
 template <typename T, typename D, tConcurrency CONCURRENCY, tDequeueMode DEQUEUE_MODE, bool BOUNDED>
 class tQueueImplementation<std::unique_ptr<T, D>, CONCURRENCY, DEQUEUE_MODE, BOUNDED> :
-  public tUniquePtrQueueImplementation<T, D, CONCURRENCY, DEQUEUE_MODE, BOUNDED, std::is_base_of<tQueueableMost, T>::value>
+  public tUniquePtrQueueImplementationSelector<T, D, CONCURRENCY, DEQUEUE_MODE, BOUNDED>::type
 {
-  typedef tUniquePtrQueueImplementation<T, D, CONCURRENCY, DEQUEUE_MODE, BOUNDED, std::is_base_of<tQueueableMost, T>::value> tBase;
+  typedef typename tUniquePtrQueueImplementationSelector<T, D, CONCURRENCY, DEQUEUE_MODE, BOUNDED>::type tBase;
 
   static_assert(sizeof(std::unique_ptr<T, D>) == sizeof(void*), "Only unique pointers with Deleter of size 0 may be used in queue. Otherwise, this would be too much info to store in an atomic.");
 
@@ -124,6 +141,118 @@ public:
 
 };
 
+/*!
+ * Queues with raw pointers: elements are not owned by queue - so they are neither deleted when
+ * they are discarded (bounded queues) nor when queue or fragments are deleted.
+ * As elements may still be linked from a queue or fragment they were dropped from,
+ * their links are reset on Enqueue.
+ */
+template <typename T, tConcurrency CONCURRENCY, tDequeueMode DEQUEUE_MODE, bool BOUNDED>
+class tQueueImplementation<T*, CONCURRENCY, DEQUEUE_MODE, BOUNDED> :
+  public tUniquePtrQueueImplementationSelector<T, tNonOwningDeleter, CONCURRENCY, DEQUEUE_MODE, BOUNDED>::type
+{
+  typedef typename tUniquePtrQueueImplementationSelector<T, tNonOwningDeleter, CONCURRENCY, DEQUEUE_MODE, BOUNDED>::type tBase;
+
+  // elements with tQueueability::INDEXED are not supported: their arena cannot be determined from T
+  static_assert(std::is_base_of<tQueueableMost, T>::value || std::is_base_of<tQueueableSingleThreaded, T>::value,
+                "Raw pointers may only be enqueued if T is derived from tQueueable<...> (tQueueability::INDEXED is not supported)");
+
+public:
+
+  inline T* Dequeue(bool& success)
+  {
+    T* result = tBase::Dequeue().release();
+    success = result;
+    return result;
+  }
+
+  inline tQueueFragment<T*> DequeueAll()
+  {
+    return tQueueFragment<T*>(tQueueFragmentImplementation<T*>(tBase::DequeueAll()));
+  }
+
+  inline void Enqueue(T* && element)
+  {
+    assert(element);
+    ResetLink<tQueueableMost>(*element, std::is_base_of<tQueueableMost, T>());
+    ResetLink<tQueueableSingleThreaded>(*element, std::is_base_of<tQueueableSingleThreaded, T>());
+    tBase::Enqueue(std::unique_ptr<T, tNonOwningDeleter>(element));
+  }
+
+private:
+
+  static void ResetLink(tQueueableMost& element)
+  {
+    element.next_queueable.store(NULL, std::memory_order_relaxed);
+  }
+
+  static void ResetLink(tQueueableSingleThreaded& element)
+  {
+    element.next_single_threaded_queueable = NULL;
+  }
+
+  template <typename TLink>
+  static void ResetLink(T& element, std::true_type)
+  {
+    ResetLink(static_cast<TLink&>(element));
+  }
+
+  template <typename TLink>
+  static void ResetLink(T&, std::false_type)
+  {
+  }
+};
+
+/*!
+ * Queues with shared pointers: the queue's references are enqueued as unique pointers to the link slot
+ */
+template <typename T, size_t SLOT, tConcurrency CONCURRENCY, tDequeueMode DEQUEUE_MODE, bool BOUNDED>
+class tQueueImplementation<tQueueableSharedPointer<T, SLOT>, CONCURRENCY, DEQUEUE_MODE, BOUNDED> : private rrlib::util::tNoncopyable
+{
+  typedef tQueueableSharedPointer<T, SLOT> tPointer;
+  typedef tQueueImplementation<typename tPointer::tQueueReference, CONCURRENCY, DEQUEUE_MODE, BOUNDED> tReferenceQueue;
+
+public:
+
+  enum { cMINIMUM_ELEMENTS_IN_QEUEUE = tReferenceQueue::cMINIMUM_ELEMENTS_IN_QEUEUE };
+
+  inline tPointer Dequeue(bool& success)
+  {
+    return tPointer::FromQueueReference(references.Dequeue(success));
+  }
+
+  inline tQueueFragment<tPointer> DequeueAll()
+  {
+    return tQueueFragment<tPointer>(tQueueFragmentImplementation<tPointer>(references.DequeueAll()));
+  }
+
+  inline void Enqueue(tPointer && element)
+  {
+    assert(element);
+    references.Enqueue(element.ToQueueReference());
+  }
+
+  int GetMaxLength() const
+  {
+    return references.GetMaxLength();
+  }
+
+  void SetMaxLength(int max_length)
+  {
+    references.SetMaxLength(max_length);
+  }
+
+  int Size()
+  {
+    return references.Size();
+  }
+
+private:
+
+  /*! Queue with references */
+  tReferenceQueue references;
+};
+
 //----------------------------------------------------------------------
 // End of namespace declaration
 //----------------------------------------------------------------------
@@ -0,0 +1,259 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/queue/tQueueNode.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tQueueNode
+ *
+ * \b tQueueNode
+ *
+ * Link node for queues of unique pointers to types that are not derived from tQueueable -
+ * together with the per-queue pool that nodes are taken from.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__concurrent_containers__queue__tQueueNode_h__
+#define __rrlib__concurrent_containers__queue__tQueueNode_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tNoncopyable.h"
+#include "rrlib/util/tTaggedPointer.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tQueueable.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+namespace queue
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+template <typename T, typename D>
+class tQueueNodePool;
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Queue node
+/*!
+ * Queueable link node that holds a pointer to an element of type T
+ * (so that unique pointers to arbitrary types can be enqueued in the intrusive queue implementations).
+ */
+template <typename T, typename D>
+class tQueueNode : public tQueueable<tQueueability::FULL>
+{
+public:
+
+  tQueueNode() : element(NULL), pool(NULL) {}
+
+  /*! Element - owned by node (deleted with D when node is deleted) */
+  T* element;
+
+  /*! Pool that node belongs to */
+  tQueueNodePool<T, D>* pool;
+};
+
+/*!
+ * Deleter for unique pointers to queue nodes:
+ * Deletes the node's element (if any) and returns node to its pool
+ */
+template <typename T, typename D>
+struct tQueueNodeDeleter
+{
+  void operator()(tQueueNode<T, D>* node) const
+  {
+    if (node->element)
+    {
+      D()(node->element);
+      node->element = NULL;
+    }
+    node->pool->Return(node);
+  }
+};
+
+/*!
+ * Pool of queue nodes - one per queue.
+ *
+ * Free nodes are kept in a lock-free stack (linked via their next_queueable pointers - stamp avoids ABA problem).
+ * Nodes are allocated in chunks of cCHUNK_SIZE and are only deleted with the pool,
+ * so enqueueing does not allocate memory once the pool contains enough nodes.
+ *
+ * As nodes may outlive their queue (e.g. in queue fragments), the pool counts
+ * one reference per node in use plus one for the queue. It deletes itself when the last reference is removed.
+ */
+template <typename T, typename D>
+class tQueueNodePool : private rrlib::util::tNoncopyable
+{
+  typedef tQueueNode<T, D> tNode;
+  typedef rrlib::util::tTaggedPointer<tQueueableMost, true, 16> tTaggedPointer;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Number of nodes allocated at once */
+  enum { cCHUNK_SIZE = 64 };
+
+  tQueueNodePool() : free_nodes(tTaggedPointer(NULL, 0)), chunks(NULL), references(1) {}
+
+  /*!
+   * \return Unused node (next_queueable is NULL)
+   */
+  tNode* GetNode()
+  {
+    references.fetch_add(1, std::memory_order_relaxed);
+    tTaggedPointer current = free_nodes.load();
+    while (current.GetPointer())
+    {
+      tQueueableMost* next = current.GetPointer()->next_queueable.load(std::memory_order_relaxed);  // nodes are only deleted with pool
+      if (free_nodes.compare_exchange_weak(current, tTaggedPointer(next, (current.GetStamp() + 1) & tTaggedPointer::cSTAMP_MASK)))
+      {
+        tNode* node = static_cast<tNode*>(current.GetPointer());
+        node->next_queueable.store(NULL, std::memory_order_relaxed);
+        return node;
+      }
+    }
+    return AllocateChunk();
+  }
+
+  /*!
+   * Removes reference of queue (called when queue is deleted)
+   */
+  void RemoveQueueReference()
+  {
+    RemoveReference();
+  }
+
+  /*!
+   * Returns unused node to pool
+   *
+   * \param node Node (its element has already been deleted or moved out)
+   */
+  void Return(tNode* node)
+  {
+    Push(node, node);
+    RemoveReference();
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Chunk of nodes */
+  struct tChunk
+  {
+    tNode nodes[cCHUNK_SIZE];
+
+    /*! Next chunk in list of all chunks */
+    tChunk* next;
+  };
+
+  /*! Stack of free nodes */
+  std::atomic<typename tTaggedPointer::tStorage> free_nodes;
+
+  /*! List of all chunks */
+  std::atomic<tChunk*> chunks;
+
+  /*! Number of nodes in use + 1 (while queue exists) */
+  std::atomic<size_t> references;
+
+  ~tQueueNodePool()
+  {
+    tChunk* chunk = chunks.load();
+    while (chunk)
+    {
+      tChunk* next = chunk->next;
+      delete chunk;
+      chunk = next;
+    }
+  }
+
+  /*!
+   * Allocates new chunk, returns its first node and pushes the others to the stack of free nodes
+   */
+  tNode* AllocateChunk()
+  {
+    tChunk* chunk = new tChunk();
+    for (size_t i = 0; i < cCHUNK_SIZE; i++)
+    {
+      chunk->nodes[i].pool = this;
+    }
+    for (size_t i = 1; i < cCHUNK_SIZE - 1; i++)
+    {
+      chunk->nodes[i].next_queueable.store(&chunk->nodes[i + 1], std::memory_order_relaxed);
+    }
+    chunk->next = chunks.load();
+    while (!chunks.compare_exchange_weak(chunk->next, chunk)) {}
+    Push(&chunk->nodes[1], &chunk->nodes[cCHUNK_SIZE - 1]);
+    return &chunk->nodes[0];
+  }
+
+  /*!
+   * Pushes chain of nodes to stack of free nodes
+   */
+  void Push(tNode* first, tNode* last)
+  {
+    tTaggedPointer current = free_nodes.load();
+    do
+    {
+      last->next_queueable.store(current.GetPointer(), std::memory_order_relaxed);
+    }
+    while (!free_nodes.compare_exchange_weak(current, tTaggedPointer(first, (current.GetStamp() + 1) & tTaggedPointer::cSTAMP_MASK)));
+  }
+
+  void RemoveReference()
+  {
+    if (references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+      delete this;
+    }
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -79,6 +79,12 @@ tQueueableSingleThreaded::tQueueableSingleThreaded() :
   next_single_threaded_queueable(NULL)
 {}
 
+tQueueableIndexed::tQueueableIndexed()
+{
+  // atomic store: queues may still read the link of a previous element in the same arena block
+  next_index.store(cNULL_INDEX, std::memory_order_relaxed);
+}
+
 
 //----------------------------------------------------------------------
 // End of namespace declaration
@@ -39,6 +39,7 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <cstdint>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
@@ -131,6 +132,24 @@ public:
   tQueueableSingleThreaded* next_single_threaded_queueable;
 };
 
+class tQueueableIndexed : private rrlib::util::tNoncopyable
+{
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Index that represents 'no element' */
+  enum { cNULL_INDEX = 0xFFFFFFFFu };
+
+  tQueueableIndexed();
+
+  /*!
+   * Index of next element in queue (in element's tIndexedArena)... cNULL_INDEX if there's none
+   */
+  std::atomic<uint32_t> next_index;
+};
+
 } // namespace
 
 template<> class tQueueable<tQueueability::SINGLE_THREADED> : public queue::tQueueableSingleThreaded {};
@@ -138,6 +157,7 @@ template<> class tQueueable<tQueueability::MOST> : public queue::tQueueableMost
 template<> class tQueueable<tQueueability::MOST_OPTIMIZED> : public queue::tQueueableMost, public queue::tQueueableSingleThreaded {};
 template<> class tQueueable<tQueueability::FULL> : public queue::tQueueableFull {};
 template<> class tQueueable<tQueueability::FULL_OPTIMIZED> : public queue::tQueueableFull, public queue::tQueueableSingleThreaded {};
+template<> class tQueueable<tQueueability::INDEXED> : public queue::tQueueableIndexed {};
 
 //----------------------------------------------------------------------
 // End of namespace declaration
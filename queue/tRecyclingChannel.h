@@ -0,0 +1,231 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/queue/tRecyclingChannel.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tRecyclingChannel
+ *
+ * \b tRecyclingChannel
+ *
+ * Lock-free return channel of a tRecyclingPool.
+ * Consumer threads push elements back to the pool they originate from.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__concurrent_containers__queue__tRecyclingChannel_h__
+#define __rrlib__concurrent_containers__queue__tRecyclingChannel_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tNoncopyable.h"
+#include <atomic>
+#include <cstddef>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tQueueable.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+namespace queue
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Return channel of recycling pool
+/*!
+ * Lock-free stack of returned elements - linked via their next_queueable pointers.
+ * Any thread may push elements (or chains of elements).
+ * Only the pool owner takes elements - always all at once (so there is no ABA problem).
+ *
+ * The channel lives as long as its pool or any element created by the pool:
+ * it counts one reference per element plus one for the pool.
+ * After the pool has been closed, returned elements are deleted immediately.
+ */
+class tRecyclingChannel : private rrlib::util::tNoncopyable
+{
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * \param delete_element Function that deletes an element of the pool
+   */
+  explicit tRecyclingChannel(void (*delete_element)(tQueueableMost*)) :
+    returned(NULL),
+    references(1),
+    delete_element(delete_element)
+  {}
+
+  /*!
+   * Adds reference for new element
+   */
+  void AddReference()
+  {
+    references.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /*!
+   * Closes channel (called by pool owner when pool is deleted)
+   * Deletes all returned elements - and elements returned later.
+   */
+  void Close()
+  {
+    size_t deleted = DeleteChain(returned.exchange(Closed(), std::memory_order_acquire));
+    RemoveReferences(deleted + 1);
+  }
+
+  /*!
+   * Deletes chain of elements
+   *
+   * \param first First element in chain (chain is terminated with NULL)
+   * \return Number of deleted elements
+   */
+  size_t DeleteChain(tQueueableMost* first)
+  {
+    size_t count = 0;
+    while (first)
+    {
+      tQueueableMost* next = first->next_queueable.load(std::memory_order_relaxed);
+      first->next_queueable.store(NULL, std::memory_order_relaxed);
+      delete_element(first);
+      first = next;
+      count++;
+    }
+    return count;
+  }
+
+  /*!
+   * Releases references (channel is deleted when last reference is released)
+   *
+   * \param count Number of references to release
+   */
+  void RemoveReferences(size_t count)
+  {
+    if (references.fetch_sub(count, std::memory_order_acq_rel) == count)
+    {
+      delete this;
+    }
+  }
+
+  /*!
+   * Returns chain of elements to pool (may be called by any thread)
+   *
+   * \param first First element in chain
+   * \param last Last element in chain (its next_queueable pointer is overwritten)
+   * \param count Number of elements in chain
+   */
+  void Return(tQueueableMost* first, tQueueableMost* last, size_t count)
+  {
+    tQueueableMost* head = returned.load(std::memory_order_relaxed);
+    do
+    {
+      if (head == Closed())
+      {
+        last->next_queueable.store(NULL, std::memory_order_relaxed);
+        DeleteChain(first);
+        RemoveReferences(count);
+        return;
+      }
+      last->next_queueable.store(head, std::memory_order_relaxed);
+    }
+    while (!returned.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  /*!
+   * Takes all returned elements (only called by pool owner)
+   *
+   * \return First element in chain of returned elements (NULL if there are none)
+   */
+  tQueueableMost* TakeAll()
+  {
+    if (!returned.load(std::memory_order_relaxed))
+    {
+      return NULL;
+    }
+    return returned.exchange(NULL, std::memory_order_acquire);
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Top of stack of returned elements (&closed_marker after pool has been deleted) */
+  std::atomic<tQueueableMost*> returned;
+
+  /*! Number of elements created by pool + 1 (as long as pool exists) */
+  std::atomic<size_t> references;
+
+  /*! Function that deletes an element of the pool */
+  void (*delete_element)(tQueueableMost*);
+
+  /*! Its address marks closed channel */
+  tQueueableMost closed_marker;
+
+  tQueueableMost* Closed()
+  {
+    return &closed_marker;
+  }
+};
+
+/*!
+ * Base class of recyclable elements (see tRecyclable)
+ */
+class tRecyclableBase
+{
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tRecyclableBase() : origin(NULL) {}
+
+  /*! Return channel of pool that element was created by */
+  tRecyclingChannel* origin;
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
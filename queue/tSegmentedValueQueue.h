@@ -0,0 +1,521 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/queue/tSegmentedValueQueue.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tSegmentedValueQueue
+ *
+ * \b tSegmentedValueQueue
+ *
+ * Unbounded concurrent queue that stores (small, trivially copyable) values inline in linked segments.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__concurrent_containers__queue__tSegmentedValueQueue_h__
+#define __rrlib__concurrent_containers__queue__tSegmentedValueQueue_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tNoncopyable.h"
+#include "rrlib/util/tTaggedPointer.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tGracePeriods.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+namespace queue
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Segmented queue of inline values
+/*!
+ * Unbounded queue for values of type T that are stored inline in linked segments
+ * with SEGMENT_SIZE slots each (no per-element nodes or allocations).
+ * Supports multiple concurrent writers and readers - and is therefore used for all concurrency levels.
+ *
+ * Writers and readers claim slots in the tail and head segment with fetch_add on the segment's
+ * enqueue and dequeue index. A writer stores the value and then marks the slot as written.
+ * A reader marks its slot as taken: if the writer has not stored its value yet, the slot
+ * is skipped and the writer retries with another slot.
+ * When the tail segment is full, a new segment is appended.
+ *
+ * Segments that all readers have passed are unlinked and retired as soon as the last reader and writer
+ * with a slot in them are done. They are recycled (via a lock-free free list) as soon as no read section
+ * that might still access them is active (see tGracePeriods). Segments are only deleted with the queue.
+ *
+ * Read sections are only entered on the slow path (segment exhausted or full).
+ * On the fast path, a stale segment pointer is harmless: indices of segments that are not
+ * (or no longer) head or tail are exhausted or closed - so a claim fails and the slow path is taken.
+ *
+ * \tparam T Type of values (must be trivially copyable)
+ * \tparam SEGMENT_SIZE Number of values per segment
+ */
+template <typename T, size_t SEGMENT_SIZE = 1024>
+class tSegmentedValueQueue : private rrlib::util::tNoncopyable
+{
+  static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be stored inline");
+  static_assert(SEGMENT_SIZE > 1, "Segments need at least two slots");
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  enum { cMINIMUM_ELEMENTS_IN_QEUEUE = 0 };
+
+  tSegmentedValueQueue() :
+    head(NULL),
+    padding(),
+    tail(NULL),
+    free_segments(tTaggedPointer(NULL, 0)),
+    retired(NULL),
+    grace_periods()
+  {
+    tSegment* segment = new tSegment();
+    segment->enqueue_index.store(0);
+    segment->dequeue_index.store(0);
+    head = segment;
+    tail = segment;
+  }
+
+  ~tSegmentedValueQueue()
+  {
+    DeleteList(head.load(), &tSegment::next);
+    DeleteList(retired.load(), &tSegment::next_retired);
+    DeleteList(tTaggedPointer(free_segments.load()).GetPointer(), &tSegment::next_free);
+  }
+
+  inline T Dequeue(bool& success)
+  {
+    while (true)
+    {
+      tSegment* segment = head.load();
+      size_t generation = segment->generation.load();
+      size_t dequeue_index = segment->dequeue_index.load();
+      if (dequeue_index < SEGMENT_SIZE)
+      {
+        if (dequeue_index >= (segment->enqueue_index.load() & ~cCLOSED) && segment->next.load() == NULL)
+        {
+          if (head.load() == segment && segment->generation.load() == generation)  // segment was head when indices were read
+          {
+            break;
+          }
+          continue;
+        }
+        size_t index = segment->dequeue_index.fetch_add(1);
+        if (index < SEGMENT_SIZE)
+        {
+          T value;
+          if (Take(*segment, index, value))
+          {
+            success = true;
+            return value;
+          }
+          continue;  // writer has not stored value yet: it will retry with another slot
+        }
+      }
+      if (!AdvanceHead())
+      {
+        break;
+      }
+    }
+    success = false;
+    return T();
+  }
+
+  inline void Enqueue(T && value)
+  {
+    while (true)
+    {
+      tSegment* segment = tail.load();
+      size_t index = segment->enqueue_index.fetch_add(1);
+      if (index < SEGMENT_SIZE)
+      {
+        if (Put(*segment, index, value))
+        {
+          return;
+        }
+        continue;  // slot was skipped by a reader
+      }
+      if (AdvanceTail(value))
+      {
+        return;
+      }
+    }
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Slot state flags */
+  enum
+  {
+    cWRITTEN = 1,  //!< Writer stored value
+    cTAKEN = 2,    //!< Reader took value or skipped slot
+    cRECYCLE = 4,  //!< Thread that finishes slot continues retiring segment (see RetireWhenFinished())
+    cFINISHED = cWRITTEN | cTAKEN
+  };
+
+  /*! Flag in enqueue and dequeue index: segment is not (yet) tail or head - no slots can be claimed */
+  static constexpr size_t cCLOSED = static_cast<size_t>(1) << (sizeof(size_t) * 8 - 1);
+
+  enum { cCACHE_LINE_SIZE = 64 };
+
+  /*! Segment with inline values */
+  struct tSegment
+  {
+    tSegment() : generation(0), next(NULL), next_free(NULL), next_retired(NULL), retire_epoch(0)
+    {
+      Reset();
+    }
+
+    /*!
+     * Resets segment for reuse. Indices are closed until segment is linked to queue.
+     */
+    void Reset()
+    {
+      generation.fetch_add(1);
+      enqueue_index.store(cCLOSED);
+      dequeue_index.store(cCLOSED);
+      next.store(NULL);
+      for (size_t i = 0; i < SEGMENT_SIZE; i++)
+      {
+        states[i].store(0, std::memory_order_relaxed);
+      }
+    }
+
+    /*! Index of next slot to claim for enqueueing */
+    std::atomic<size_t> enqueue_index;
+
+    /*! Keeps indices in separate cache lines */
+    char padding[cCACHE_LINE_SIZE];
+
+    /*! Index of next slot to claim for dequeueing */
+    std::atomic<size_t> dequeue_index;
+
+    /*! Incremented whenever segment is reset (detects recycling of segment while reading its indices without read section) */
+    std::atomic<size_t> generation;
+
+    /*! Next segment in queue */
+    std::atomic<tSegment*> next;
+
+    /*! Next segment in free list */
+    std::atomic<tSegment*> next_free;
+
+    /*! Next segment in list of retired segments */
+    tSegment* next_retired;
+
+    /*! Epoch in which segment was retired */
+    size_t retire_epoch;
+
+    /*! States of slots */
+    std::atomic<uint8_t> states[SEGMENT_SIZE];
+
+    /*! Values (contiguous) */
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type values[SEGMENT_SIZE];
+  };
+
+  typedef rrlib::util::tTaggedPointer<tSegment, true, 16> tTaggedPointer;
+
+  /*! First segment (readers) */
+  std::atomic<tSegment*> head;
+
+  /*! Keeps head and tail in separate cache lines */
+  char padding[cCACHE_LINE_SIZE];
+
+  /*! Last segment (writers) */
+  std::atomic<tSegment*> tail;
+
+  /*! Stack of recycled segments (stamp avoids ABA problem) */
+  std::atomic<typename tTaggedPointer::tStorage> free_segments;
+
+  /*! Stack of retired segments */
+  std::atomic<tSegment*> retired;
+
+  /*! Grace periods for recycling retired segments */
+  tGracePeriods grace_periods;
+
+  /*!
+   * Slow path of Dequeue(): opens head segment - or moves head to next segment if head segment is exhausted
+   *
+   * \return False if queue is empty
+   */
+  bool AdvanceHead()
+  {
+    tGracePeriods::tReadSection read_section(grace_periods);
+    tSegment* segment = head.load();
+    size_t dequeue_index = segment->dequeue_index.load();
+    if (dequeue_index & cCLOSED)
+    {
+      Open(segment->dequeue_index, 0);
+      return true;
+    }
+    if (dequeue_index < SEGMENT_SIZE)
+    {
+      return true;
+    }
+    tSegment* next = segment->next.load();
+    if (!next)
+    {
+      return false;
+    }
+    tSegment* expected_tail = segment;
+    tail.compare_exchange_strong(expected_tail, next);  // segment must not be reachable via tail when it is retired
+    if (head.compare_exchange_strong(segment, next))
+    {
+      Open(next->dequeue_index, 0);
+      RetireWhenFinished(*segment, 0);
+    }
+    return true;
+  }
+
+  /*!
+   * Slow path of Enqueue(): opens tail segment - or moves tail to next segment or appends new segment if tail segment is full
+   *
+   * \param value Value to store in first slot of new segment
+   * \return True if value was enqueued (in new segment)
+   */
+  bool AdvanceTail(const T& value)
+  {
+    tGracePeriods::tReadSection read_section(grace_periods);
+    tSegment* segment = tail.load();
+    size_t enqueue_index = segment->enqueue_index.load();
+    if (enqueue_index & cCLOSED)
+    {
+      Open(segment->enqueue_index, 1);
+      return false;
+    }
+    if (enqueue_index < SEGMENT_SIZE)
+    {
+      return false;
+    }
+    tSegment* next = segment->next.load();
+    if (next)
+    {
+      tail.compare_exchange_strong(segment, next);
+      return false;
+    }
+    tSegment* new_segment = GetFreeSegment();
+    new(&new_segment->values[0]) T(value);
+    new_segment->states[0].store(cWRITTEN, std::memory_order_relaxed);
+    tSegment* expected_next = NULL;
+    if (segment->next.compare_exchange_strong(expected_next, new_segment))
+    {
+      Open(new_segment->enqueue_index, 1);
+      tail.compare_exchange_strong(segment, new_segment);
+      return true;
+    }
+    new_segment->Reset();
+    PushFreeSegment(new_segment);
+    return false;
+  }
+
+  /*!
+   * Opens closed index of segment that is now linked to queue (head or tail)
+   *
+   * \param index Index to open
+   * \param value Value of opened index
+   */
+  static void Open(std::atomic<size_t>& index, size_t value)
+  {
+    size_t current = index.load();
+    while ((current & cCLOSED) && !index.compare_exchange_weak(current, value));
+  }
+
+  /*!
+   * Stores value in claimed slot
+   *
+   * \return True if value was stored - false if slot was skipped by reader
+   */
+  bool Put(tSegment& segment, size_t index, const T& value)
+  {
+    new(&segment.values[index]) T(value);
+    uint8_t previous_state = segment.states[index].fetch_or(cWRITTEN, std::memory_order_acq_rel);
+    if (previous_state & cTAKEN)
+    {
+      if (previous_state & cRECYCLE)
+      {
+        RetireWhenFinished(segment, index + 1);
+      }
+      return false;
+    }
+    return true;
+  }
+
+  /*!
+   * Takes value from claimed slot
+   *
+   * \param value Receives value
+   * \return True if value was taken - false if slot was skipped (writer has not stored its value yet)
+   */
+  bool Take(tSegment& segment, size_t index, T& value)
+  {
+    std::atomic<uint8_t>& state = segment.states[index];
+    uint8_t current = state.load(std::memory_order_acquire);
+    while (!(current & cWRITTEN))
+    {
+      if (state.compare_exchange_weak(current, current | cTAKEN, std::memory_order_acq_rel))
+      {
+        return false;
+      }
+    }
+    value = *reinterpret_cast<T*>(&segment.values[index]);
+    if (state.fetch_or(cTAKEN, std::memory_order_acq_rel) & cRECYCLE)
+    {
+      RetireWhenFinished(segment, index + 1);
+    }
+    return true;
+  }
+
+  /*!
+   * Retires unlinked segment as soon as the writer and reader of each slot are done with it.
+   * If a slot is not finished yet, it is flagged - and the thread finishing it calls this again.
+   *
+   * \param segment Unlinked segment
+   * \param first_slot First slot to check
+   */
+  void RetireWhenFinished(tSegment& segment, size_t first_slot)
+  {
+    for (size_t i = first_slot; i < SEGMENT_SIZE; i++)
+    {
+      if ((segment.states[i].load(std::memory_order_acquire) & cFINISHED) != cFINISHED &&
+          (segment.states[i].fetch_or(cRECYCLE, std::memory_order_acq_rel) & cFINISHED) != cFINISHED)
+      {
+        return;
+      }
+    }
+    Retire(&segment);
+  }
+
+  template <typename TNext>
+  static void DeleteList(tSegment* segment, TNext tSegment::* next)
+  {
+    while (segment)
+    {
+      tSegment* temp = segment;
+      segment = temp->*next;
+      delete temp;
+    }
+  }
+
+  /*!
+   * \return Reset segment from free list - or new segment if free list is empty
+   */
+  tSegment* GetFreeSegment()
+  {
+    tTaggedPointer current = free_segments.load();
+    while (current.GetPointer())
+    {
+      tSegment* next = current.GetPointer()->next_free.load(std::memory_order_relaxed);  // segments are only deleted with queue
+      if (free_segments.compare_exchange_weak(current, tTaggedPointer(next, (current.GetStamp() + 1) & tTaggedPointer::cSTAMP_MASK)))
+      {
+        return current.GetPointer();
+      }
+    }
+    return new tSegment();
+  }
+
+  void PushFreeSegment(tSegment* segment)
+  {
+    tTaggedPointer current = free_segments.load();
+    do
+    {
+      segment->next_free.store(current.GetPointer(), std::memory_order_relaxed);
+    }
+    while (!free_segments.compare_exchange_weak(current, tTaggedPointer(segment, (current.GetStamp() + 1) & tTaggedPointer::cSTAMP_MASK)));
+  }
+
+  /*!
+   * Retires unlinked segment and recycles retired segments that no read section can access anymore
+   */
+  void Retire(tSegment* segment)
+  {
+    segment->retire_epoch = grace_periods.GetEpoch();
+    segment->next_retired = retired.load();
+    while (!retired.compare_exchange_weak(segment->next_retired, segment));
+
+    if (!grace_periods.TryAdvance())
+    {
+      return;
+    }
+    size_t epoch = grace_periods.GetEpoch();
+    tSegment* stack = retired.exchange(NULL);
+    tSegment* keep_first = NULL;
+    tSegment* keep_last = NULL;
+    while (stack)
+    {
+      tSegment* next = stack->next_retired;
+      if (stack->retire_epoch + 2 <= epoch)
+      {
+        stack->Reset();
+        PushFreeSegment(stack);
+      }
+      else
+      {
+        stack->next_retired = keep_first;
+        keep_first = stack;
+        keep_last = keep_last ? keep_last : stack;
+      }
+      stack = next;
+    }
+    if (keep_first)
+    {
+      keep_last->next_retired = retired.load();
+      while (!retired.compare_exchange_weak(keep_last->next_retired, keep_first));
+    }
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
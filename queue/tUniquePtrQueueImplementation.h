@@ -48,6 +48,8 @@
 #include "rrlib/concurrent_containers/queue/tIntrusiveLinkedFifoQueue.h"
 #include "rrlib/concurrent_containers/queue/tIntrusiveLinkedBoundedFifoQueue.h"
 #include "rrlib/concurrent_containers/queue/tIntrusiveLinkedFragmentBasedQueue.h"
+#include "rrlib/concurrent_containers/queue/tIntrusiveLinkedBoundedFragmentBasedQueue.h"
+#include "rrlib/concurrent_containers/queue/tNodeQueue.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -62,39 +64,17 @@ namespace queue
 //----------------------------------------------------------------------
 // Forward declarations / typedefs / enums
 //----------------------------------------------------------------------
-template <typename T, tConcurrency CONCURRENCY, tDequeueMode DEQUEUE_MODE, bool BOUNDED>
-class tQueueImplementation;
-
 //----------------------------------------------------------------------
 // Class declaration
 //----------------------------------------------------------------------
 //! Unique pointer queues
 /*!
  * Implementation for all queues dealing with unique pointers.
+ * (default implementation for types not derived from tQueueable: elements are wrapped in queue nodes)
  */
 template <typename T, typename D, tConcurrency CONCURRENCY, tDequeueMode DEQUEUE_MODE, bool BOUNDED, bool QUEUEABLE_TYPE>
-class tUniquePtrQueueImplementation : public tQueueImplementation<T, CONCURRENCY, DEQUEUE_MODE, BOUNDED>
+class tUniquePtrQueueImplementation : public tNodeQueue<T, D, CONCURRENCY, DEQUEUE_MODE, BOUNDED>
 {
-  // this combination of parameters is not supported yet - TODO: put pointers in ordinary queue
-
-//----------------------------------------------------------------------
-// Public methods and typedefs
-//----------------------------------------------------------------------
-  /*public:
-
-    typedef std::unique_ptr<T, D> tPointer;
-    typedef tQueueImplementation<T, CONCURRENCY, DEQUEUE_MODE, BOUNDED> tBase;
-
-    inline tPointer Dequeue()
-    {
-      bool success = false;
-      return tPointer(tBase::Dequeue(success));
-    }
-
-    inline void Enqueue(tPointer && element)
-    {
-      tBase::Enqueue(element.release());
-    }*/
 };
 
 template <typename T, typename D, tConcurrency CONCURRENCY, tDequeueMode DEQUEUE_MODE, bool BOUNDED>
@@ -117,7 +97,7 @@ class tUniquePtrQueueImplementation<T, D, tConcurrency::NONE, DEQUEUE_MODE, BOUN
 
 template <typename T, typename D, tDequeueMode DEQUEUE_MODE, bool BOUNDED>
 class tUniquePtrQueueImplementation<T, D, tConcurrency::NONE, DEQUEUE_MODE, BOUNDED, false> :
-  public tIntrusiveSingleThreadedQueue<T, D, BOUNDED, false, std::is_base_of<tQueueableSingleThreaded, T>::value>
+  public std::conditional<std::is_base_of<tQueueableSingleThreaded, T>::value, tIntrusiveSingleThreadedQueue<T, D, BOUNDED, false, true>, tNodeQueue<T, D, tConcurrency::NONE, DEQUEUE_MODE, BOUNDED>>::type
 {
 };
 
@@ -155,6 +135,12 @@ class tConcurrentIntrusiveQueue<T, D, CONCURRENCY, tDequeueMode::ALL, BOUNDED> :
 {
 };
 
+template <typename T, typename D, tConcurrency CONCURRENCY>
+class tConcurrentIntrusiveQueue<T, D, CONCURRENCY, tDequeueMode::ALL, true> :
+  public std::conditional<std::is_base_of<tQueueableFull, T>::value || (!tAllowBlockingBoundedFragmentQueue<T>::value), tIntrusiveLinkedFragmentBasedQueue<T, D, CONCURRENCY, true>, tIntrusiveLinkedBoundedFragmentBasedQueue<T, D, CONCURRENCY>>::type
+{
+};
+
 //----------------------------------------------------------------------
 // End of namespace declaration
 //----------------------------------------------------------------------
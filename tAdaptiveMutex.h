@@ -0,0 +1,220 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/tAdaptiveMutex.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tAdaptiveMutex
+ *
+ * \b tAdaptiveMutex
+ *
+ * Mutex for very short critical sections: spins briefly before it parks waiting threads in the kernel.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__concurrent_containers__tAdaptiveMutex_h__
+#define __rrlib__concurrent_containers__tAdaptiveMutex_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tNoncopyable.h"
+#include <atomic>
+#include <thread>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Spin-then-park mutex
+/*!
+ * Mutex tuned for very short critical sections - such as modifications of tSet with ArrayChunkBased storage.
+ * Uncontended locking and unlocking costs a single atomic operation each.
+ * With contention, a thread first spins for a short time (with pause instructions) -
+ * as the critical section is likely to be left by then.
+ * Only if this is not the case, it parks on a futex (Linux; yields on other platforms).
+ *
+ * Can be used as TMutex parameter of tSet (with ArrayChunkBased storage).
+ * The mutex is not recursive.
+ */
+class tAdaptiveMutex : private rrlib::util::tNoncopyable
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Lock (RAII) */
+  class tLock : private rrlib::util::tNoncopyable
+  {
+  public:
+    explicit tLock(tAdaptiveMutex& mutex) : mutex(mutex)
+    {
+      mutex.Lock();
+    }
+
+    ~tLock()
+    {
+      mutex.Unlock();
+    }
+
+  private:
+    tAdaptiveMutex& mutex;
+  };
+
+  /*! Number of spin iterations before thread is parked (about a microsecond on current x86 CPUs) */
+  enum { cSPIN_ITERATIONS = 64 };
+
+  tAdaptiveMutex() : state(cUNLOCKED) {}
+
+  /*!
+   * Acquires mutex (blocks until it is available)
+   */
+  void Lock()
+  {
+    int expected = cUNLOCKED;
+    if (!state.compare_exchange_strong(expected, cLOCKED, std::memory_order_acquire))
+    {
+      LockContended();
+    }
+  }
+
+  /*!
+   * Tries to acquire mutex without blocking
+   *
+   * \return True if mutex was acquired
+   */
+  bool TryLock()
+  {
+    int expected = cUNLOCKED;
+    return state.compare_exchange_strong(expected, cLOCKED, std::memory_order_acquire);
+  }
+
+  /*!
+   * Releases mutex (must be held by calling thread)
+   */
+  void Unlock()
+  {
+    if (state.exchange(cUNLOCKED, std::memory_order_release) == cLOCKED_WITH_WAITERS)
+    {
+      Wake();
+    }
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Values of state variable */
+  enum
+  {
+    cUNLOCKED,
+    cLOCKED,
+    cLOCKED_WITH_WAITERS
+  };
+
+  /*! Mutex state (see enum above) */
+  std::atomic<int> state;
+
+  static_assert(sizeof(std::atomic<int>) == sizeof(int), "Futex requires atomic int to have the size of int");
+
+  /*! Acquires mutex if it is held by another thread */
+  void LockContended()
+  {
+    for (int i = 0; i < cSPIN_ITERATIONS; i++)
+    {
+      Pause();
+      int expected = cUNLOCKED;
+      if (state.load(std::memory_order_relaxed) == cUNLOCKED && state.compare_exchange_weak(expected, cLOCKED, std::memory_order_acquire))
+      {
+        return;
+      }
+    }
+
+    // Park (after marking that there are waiters - so that unlocking thread wakes us)
+    while (state.exchange(cLOCKED_WITH_WAITERS, std::memory_order_acquire) != cUNLOCKED)
+    {
+      Wait();
+    }
+  }
+
+  /*! Spin loop hint */
+  static void Pause()
+  {
+#if defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#endif
+  }
+
+  /*! Waits until state is changed or thread is woken up */
+  void Wait()
+  {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<int*>(&state), FUTEX_WAIT_PRIVATE, cLOCKED_WITH_WAITERS, NULL, NULL, 0);
+#else
+    std::this_thread::yield();
+#endif
+  }
+
+  /*! Wakes up one waiting thread */
+  void Wake()
+  {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<int*>(&state), FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#endif
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
@@ -0,0 +1,330 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/tByteQueue.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tByteQueue
+ *
+ * \b tByteQueue
+ *
+ * Queue for variable-length records (e.g. log records or serialized messages)
+ * that are stored in a contiguous ring buffer.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__concurrent_containers__tByteQueue_h__
+#define __rrlib__concurrent_containers__tByteQueue_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tNoncopyable.h"
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tConcurrency.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Ring buffer queue for variable-length records
+/*!
+ * Non-blocking queue for records of arbitrary size - stored in a contiguous ring buffer
+ * that is allocated in the constructor (so enqueueing and dequeueing never allocate memory).
+ *
+ * Each record is prefixed with an 8-byte header containing its length. Records are
+ * cRECORD_ALIGNMENT-aligned and never wrap around the end of the buffer: if a record does not
+ * fit in the remaining bytes, these are skipped (with a padding record).
+ *
+ * Writing is done in two phases - without copying: Reserve() returns memory for the record
+ * that the writer fills before publishing it with Commit().
+ * The reader obtains the oldest record with Peek() and removes it with Release() when done.
+ *
+ * With a single writer, the writer publishes its position on Commit().
+ * With multiple writers, records are reserved with a compare-and-swap on the write position -
+ * and may be committed in any order: the reader waits for the oldest record's committed flag in its header.
+ * For this, the reader zeroes released bytes.
+ *
+ * \tparam CONCURRENCY Concurrency that queue should support (only a single reader is supported)
+ */
+template <tConcurrency CONCURRENCY>
+class tByteQueue : private rrlib::util::tNoncopyable
+{
+  static_assert(CONCURRENCY == tConcurrency::NONE || CONCURRENCY == tConcurrency::SINGLE_READER_AND_WRITER || CONCURRENCY == tConcurrency::MULTIPLE_WRITERS,
+                "tByteQueue supports only a single reader");
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Alignment of records (and size of record header) */
+  enum { cRECORD_ALIGNMENT = 8 };
+
+  /*!
+   * \param capacity Size of ring buffer in bytes (must be a power of two and at least 2 * cRECORD_ALIGNMENT)
+   */
+  explicit tByteQueue(size_t capacity) :
+    capacity(capacity),
+    buffer(new uint64_t[capacity / sizeof(uint64_t)]()),
+    padding1(),
+    write_position(0),
+    cached_read_position(0),
+    reserved_end(0),
+    padding2(),
+    read_position(0),
+    cached_write_position(0)
+  {
+    assert((capacity & (capacity - 1)) == 0 && capacity >= 2 * cRECORD_ALIGNMENT && "Capacity must be a power of two");
+  }
+
+  /*!
+   * Publishes reserved record (so that reader can obtain it)
+   *
+   * \param record Memory returned by Reserve()
+   */
+  void Commit(void* record)
+  {
+    std::atomic<uint64_t>& header = Header(static_cast<char*>(record) - cRECORD_ALIGNMENT);
+    header.store(header.load(std::memory_order_relaxed) | cCOMMITTED, std::memory_order_release);
+    if (!cMULTIPLE_WRITERS)
+    {
+      write_position.store(reserved_end, std::memory_order_release);
+    }
+  }
+
+  /*!
+   * \return Size of ring buffer in bytes
+   */
+  size_t GetCapacity() const
+  {
+    return capacity;
+  }
+
+  /*!
+   * \return Maximum size of a record (larger records can never be reserved).
+   */
+  size_t GetMaxRecordSize() const
+  {
+    return capacity / 2 - cRECORD_ALIGNMENT;
+  }
+
+  /*!
+   * Obtains oldest record in queue - without removing it.
+   * May only be called by the reader thread.
+   *
+   * \param size Contains size of record in bytes after call
+   * \return Record - or NULL if queue is empty or oldest record has not been committed yet
+   */
+  const void* Peek(size_t& size)
+  {
+    while (true)
+    {
+      uint64_t position = read_position.load(std::memory_order_relaxed);
+      if (!cMULTIPLE_WRITERS && position == cached_write_position)
+      {
+        cached_write_position = write_position.load(std::memory_order_acquire);
+        if (position == cached_write_position)
+        {
+          return NULL;
+        }
+      }
+      char* record = Record(position);
+      uint64_t header = Header(record).load(std::memory_order_acquire);
+      if ((header & cCOMMITTED) == 0)
+      {
+        return NULL;
+      }
+      if (header & cPADDING)
+      {
+        Release(position, header >> cFLAG_BITS);
+        continue;
+      }
+      size = header >> cFLAG_BITS;
+      return record + cRECORD_ALIGNMENT;
+    }
+  }
+
+  /*!
+   * Removes oldest record (returned by last call to Peek()) from queue.
+   * The record's memory may be reused by writers after this call.
+   * May only be called by the reader thread.
+   */
+  void Release()
+  {
+    uint64_t position = read_position.load(std::memory_order_relaxed);
+    uint64_t header = Header(Record(position)).load(std::memory_order_relaxed);
+    assert((header & cCOMMITTED) && (!(header & cPADDING)) && "Release() may only be called after Peek() returned a record");
+    Release(position, RecordSize(header >> cFLAG_BITS));
+  }
+
+  /*!
+   * Reserves memory for a record.
+   * Does not block: if there is not enough free space, NULL is returned.
+   * With a single writer, the reserved record must be committed before the next call.
+   *
+   * \param size Size of record in bytes (at most GetMaxRecordSize())
+   * \return Memory for record (cRECORD_ALIGNMENT-aligned) - or NULL if queue is full
+   */
+  void* Reserve(size_t size)
+  {
+    assert(size <= GetMaxRecordSize());
+    uint64_t record_size = RecordSize(size);
+    uint64_t position = write_position.load(std::memory_order_relaxed);
+    uint64_t skip;
+    while (true)
+    {
+      uint64_t offset = position & (capacity - 1);
+      skip = offset + record_size > capacity ? capacity - offset : 0;
+      uint64_t end = position + skip + record_size;
+      if (end - cached_read_position > capacity)
+      {
+        uint64_t current_read_position = read_position.load(std::memory_order_acquire);
+        if (!cMULTIPLE_WRITERS)
+        {
+          cached_read_position = current_read_position;
+        }
+        if (end - current_read_position > capacity)
+        {
+          return NULL;
+        }
+      }
+      if (!cMULTIPLE_WRITERS)
+      {
+        reserved_end = end;
+        break;
+      }
+      if (write_position.compare_exchange_weak(position, end, std::memory_order_relaxed))
+      {
+        break;
+      }
+    }
+
+    if (skip)
+    {
+      Header(Record(position)).store((skip << cFLAG_BITS) | cPADDING | cCOMMITTED, std::memory_order_release);
+    }
+    char* record = Record(position + skip);
+    Header(record).store(size << cFLAG_BITS, std::memory_order_relaxed);
+    return record + cRECORD_ALIGNMENT;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  enum { cCACHE_LINE_SIZE = 64 };
+
+  /*! Flags in record header (record size is stored in the remaining bits) */
+  enum
+  {
+    cCOMMITTED = 1,
+    cPADDING = 2,
+    cFLAG_BITS = 2
+  };
+
+  enum { cMULTIPLE_WRITERS = CONCURRENCY == tConcurrency::MULTIPLE_WRITERS };
+
+  /*! Size of ring buffer in bytes */
+  const size_t capacity;
+
+  /*! Ring buffer (zero-initialized, so that no record is committed) */
+  std::unique_ptr<uint64_t[]> buffer;
+
+  char padding1[cCACHE_LINE_SIZE];
+
+  /*!
+   * Position after last reserved record (multiple writers) or after last committed record (single writer).
+   * Positions are absolute byte counts - offsets in buffer are obtained by masking.
+   */
+  std::atomic<uint64_t> write_position;
+
+  /*! Read position writer last obtained (only used with a single writer) */
+  uint64_t cached_read_position;
+
+  /*! End of reserved record (only used with a single writer) */
+  uint64_t reserved_end;
+
+  char padding2[cCACHE_LINE_SIZE];
+
+  /*! Position of oldest record in queue */
+  std::atomic<uint64_t> read_position;
+
+  /*! Write position reader last obtained (only used with a single writer) */
+  uint64_t cached_write_position;
+
+  static std::atomic<uint64_t>& Header(char* record)
+  {
+    return *reinterpret_cast<std::atomic<uint64_t>*>(record);
+  }
+
+  char* Record(uint64_t position) const
+  {
+    return reinterpret_cast<char*>(buffer.get()) + (position & (capacity - 1));
+  }
+
+  static uint64_t RecordSize(size_t size)
+  {
+    return cRECORD_ALIGNMENT + ((size + cRECORD_ALIGNMENT - 1) & ~static_cast<uint64_t>(cRECORD_ALIGNMENT - 1));
+  }
+
+  void Release(uint64_t position, uint64_t bytes)
+  {
+    if (cMULTIPLE_WRITERS)
+    {
+      // headers of future records may be located anywhere in released bytes
+      memset(Record(position), 0, bytes);
+    }
+    read_position.store(position + bytes, std::memory_order_release);
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
@@ -0,0 +1,439 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/tConcurrentVector.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tConcurrentVector
+ *
+ * \b tConcurrentVector
+ *
+ * Append-only vector with lock-free PushBack, O(1) random access and stable element addresses.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__concurrent_containers__tConcurrentVector_h__
+#define __rrlib__concurrent_containers__tConcurrentVector_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tNoncopyable.h"
+#include <atomic>
+#include <cassert>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Append-only concurrent vector
+/*!
+ * Append-only vector with stable indices and element addresses.
+ *
+ * Elements are stored in chunks with geometrically growing sizes (FIRST_CHUNK_SIZE, 2 * FIRST_CHUNK_SIZE, 4 * FIRST_CHUNK_SIZE, ...)
+ * - like the further chunks of ArrayChunkBased sets with CHUNK_SIZE_INCREASE_FACTOR 2.
+ * Chunks are referenced by a fixed-size chunk directory, so that the chunk of an index is
+ * computed with a 'count leading zeros' instruction and random access is O(1).
+ * Chunks are never moved or deallocated before the vector is deleted - so element addresses are stable.
+ *
+ * PushBack is lock-free and may be called concurrently: it reserves an index with an atomic increment,
+ * allocates the index's chunk if necessary (concurrently allocated chunks are resolved with compare-and-swap),
+ * constructs the element and marks it as ready.
+ * Size() returns the published size: the number of elements at the front of the vector that are all ready.
+ * Readers may access and iterate over all elements below the published size - concurrently to PushBack calls.
+ * Writes to elements are not synchronized by the vector (elements may e.g. contain atomic variables).
+ *
+ * \tparam T Type of vector elements
+ * \tparam FIRST_CHUNK_SIZE Number of elements in first chunk (must be a power of two)
+ */
+template <typename T, size_t FIRST_CHUNK_SIZE = 16>
+class tConcurrentVector : private rrlib::util::tNoncopyable
+{
+  static_assert(FIRST_CHUNK_SIZE > 0 && (FIRST_CHUNK_SIZE & (FIRST_CHUNK_SIZE - 1)) == 0, "FIRST_CHUNK_SIZE must be a power of two");
+
+  /*! Element slot */
+  struct tSlot
+  {
+    /*! Storage for element */
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+    /*! True as soon as element has been constructed */
+    std::atomic<bool> ready;
+  };
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Iterator over the vector's elements (random access to elements via index) */
+  template <bool CONST>
+  class tIteratorImplementation : public std::iterator<std::random_access_iterator_tag, typename std::conditional<CONST, const T, T>::type, ptrdiff_t>
+  {
+    typedef std::iterator<std::random_access_iterator_tag, typename std::conditional<CONST, const T, T>::type, ptrdiff_t> tBase;
+    typedef typename std::conditional<CONST, const tConcurrentVector, tConcurrentVector>::type tVector;
+
+  public:
+
+    tIteratorImplementation() : vector(NULL), index(0) {}
+    tIteratorImplementation(tVector& vector, size_t index) : vector(&vector), index(index) {}
+
+    inline typename tBase::reference operator*() const
+    {
+      return (*vector)[index];
+    }
+    inline typename tBase::pointer operator->() const
+    {
+      return &(operator*());
+    }
+    inline typename tBase::reference operator[](ptrdiff_t offset) const
+    {
+      return (*vector)[index + offset];
+    }
+
+    inline tIteratorImplementation& operator++()
+    {
+      index++;
+      return *this;
+    }
+    inline tIteratorImplementation operator++(int)
+    {
+      tIteratorImplementation temp(*this);
+      index++;
+      return temp;
+    }
+    inline tIteratorImplementation& operator--()
+    {
+      index--;
+      return *this;
+    }
+    inline tIteratorImplementation operator--(int)
+    {
+      tIteratorImplementation temp(*this);
+      index--;
+      return temp;
+    }
+    inline tIteratorImplementation& operator+=(ptrdiff_t offset)
+    {
+      index += offset;
+      return *this;
+    }
+    inline tIteratorImplementation& operator-=(ptrdiff_t offset)
+    {
+      index -= offset;
+      return *this;
+    }
+    inline tIteratorImplementation operator+(ptrdiff_t offset) const
+    {
+      return tIteratorImplementation(*vector, index + offset);
+    }
+    inline tIteratorImplementation operator-(ptrdiff_t offset) const
+    {
+      return tIteratorImplementation(*vector, index - offset);
+    }
+    inline ptrdiff_t operator-(const tIteratorImplementation& other) const
+    {
+      return static_cast<ptrdiff_t>(index) - static_cast<ptrdiff_t>(other.index);
+    }
+
+    inline const bool operator == (const tIteratorImplementation &other) const
+    {
+      return index == other.index;
+    }
+    inline const bool operator != (const tIteratorImplementation &other) const
+    {
+      return index != other.index;
+    }
+    inline const bool operator < (const tIteratorImplementation &other) const
+    {
+      return index < other.index;
+    }
+    inline const bool operator > (const tIteratorImplementation &other) const
+    {
+      return index > other.index;
+    }
+    inline const bool operator <= (const tIteratorImplementation &other) const
+    {
+      return index <= other.index;
+    }
+    inline const bool operator >= (const tIteratorImplementation &other) const
+    {
+      return index >= other.index;
+    }
+
+  private:
+
+    /*! Vector that iterator belongs to */
+    tVector* vector;
+
+    /*! Index of current element */
+    size_t index;
+  };
+
+  typedef tIteratorImplementation<false> tIterator;
+  typedef tIteratorImplementation<true> tConstIterator;
+
+  tConcurrentVector() :
+    reserved_size(0),
+    published_size(0)
+  {
+    for (size_t i = 0; i < cCHUNK_COUNT; i++)
+    {
+      chunks[i].store(NULL, std::memory_order_relaxed);
+    }
+  }
+
+  ~tConcurrentVector()
+  {
+    size_t size = reserved_size.load();
+    for (size_t i = 0; i < size; i++)
+    {
+      tSlot& slot = Slot(i);
+      assert(slot.ready.load() && "PushBack must not be called concurrently to destructor");
+      reinterpret_cast<T*>(&slot.storage)->~T();
+    }
+    for (size_t i = 0; i < cCHUNK_COUNT; i++)
+    {
+      delete[] chunks[i].load();
+    }
+  }
+
+  /*!
+   * \param index Index of element (must be smaller than Size())
+   * \return Element with specified index
+   */
+  T& operator[](size_t index)
+  {
+    assert(index < published_size.load());
+    return *reinterpret_cast<T*>(&Slot(index).storage);
+  }
+  const T& operator[](size_t index) const
+  {
+    assert(index < published_size.load());
+    return *reinterpret_cast<const T*>(&Slot(index).storage);
+  }
+
+  /*!
+   * \return Iterator pointing to first element
+   */
+  tIterator Begin()
+  {
+    return tIterator(*this, 0);
+  }
+  tConstIterator Begin() const
+  {
+    return tConstIterator(*this, 0);
+  }
+
+  /*!
+   * Constructs element at the end of the vector (lock-free)
+   *
+   * \param args Arguments for element's constructor
+   * \return Index of new element (element is accessible via this index as soon as Size() is larger)
+   */
+  template <typename ... TArgs>
+  size_t EmplaceBack(TArgs && ... args)
+  {
+    size_t index = reserved_size.fetch_add(1);
+    tSlot& slot = AllocateSlot(index);
+    new(&slot.storage) T(std::forward<TArgs>(args)...);
+    slot.ready.store(true);
+    Publish();
+    return index;
+  }
+
+  /*!
+   * \return True if vector has no published elements
+   */
+  bool Empty() const
+  {
+    return Size() == 0;
+  }
+
+  /*!
+   * \return Iterator pointing past the last published element (at the time of the call)
+   */
+  tIterator End()
+  {
+    return tIterator(*this, Size());
+  }
+  tConstIterator End() const
+  {
+    return tConstIterator(*this, Size());
+  }
+
+  /*!
+   * Appends element to vector (lock-free)
+   *
+   * \param element Element to append
+   * \return Index of new element (element is accessible via this index as soon as Size() is larger)
+   */
+  size_t PushBack(const T& element)
+  {
+    return EmplaceBack(element);
+  }
+  size_t PushBack(T && element)
+  {
+    return EmplaceBack(std::move(element));
+  }
+
+  /*!
+   * \return Published size: All elements with smaller indices are constructed and may be accessed.
+   */
+  size_t Size() const
+  {
+    return published_size.load(std::memory_order_acquire);
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! log2 of a power of two */
+  static constexpr size_t Log2(size_t value)
+  {
+    return value <= 1 ? 0 : 1 + Log2(value >> 1);
+  }
+
+  /*! Maximum number of chunks (sufficient for all indices representable with size_t) */
+  enum { cCHUNK_COUNT = sizeof(size_t) * 8 - Log2(FIRST_CHUNK_SIZE) };
+
+  /*! Chunk directory: chunk i contains (FIRST_CHUNK_SIZE << i) elements - starting with index FIRST_CHUNK_SIZE * (2^i - 1) */
+  std::atomic<tSlot*> chunks[cCHUNK_COUNT];
+
+  /*! Number of indices reserved by PushBack calls */
+  std::atomic<size_t> reserved_size;
+
+  /*! Number of elements at the front of the vector that are all constructed */
+  std::atomic<size_t> published_size;
+
+
+  /*!
+   * Advances published size after an element has been constructed.
+   * Each thread that constructed an element advances it as far as possible.
+   * (if an element in front is not ready yet, the thread constructing it will advance published size later)
+   */
+  void Publish()
+  {
+    size_t published = published_size.load();
+    while (published < reserved_size.load() && Ready(published))
+    {
+      if (published_size.compare_exchange_weak(published, published + 1))
+      {
+        published++;
+      }
+    }
+  }
+
+  /*!
+   * Determines position of element in chunk directory
+   *
+   * \param index Index of element
+   * \param chunk_index Index of chunk (output)
+   * \return Offset of element in chunk
+   */
+  static size_t ChunkPosition(size_t index, size_t& chunk_index)
+  {
+    chunk_index = sizeof(size_t) * 8 - 1 - __builtin_clzl(index / FIRST_CHUNK_SIZE + 1);
+    return index - FIRST_CHUNK_SIZE * ((static_cast<size_t>(1) << chunk_index) - 1);
+  }
+
+  /*!
+   * \param index Index of element (must have been reserved)
+   * \return True if element has been constructed
+   */
+  bool Ready(size_t index) const
+  {
+    size_t chunk_index = 0;
+    size_t offset = ChunkPosition(index, chunk_index);
+    tSlot* chunk = chunks[chunk_index].load();
+    return chunk && chunk[offset].ready.load();  // chunk might not have been allocated yet
+  }
+
+  /*!
+   * \param index Index of element (its chunk must have been allocated)
+   * \return Slot of element with specified index
+   */
+  tSlot& Slot(size_t index) const
+  {
+    size_t chunk_index = 0;
+    size_t offset = ChunkPosition(index, chunk_index);
+    tSlot* chunk = chunks[chunk_index].load(std::memory_order_acquire);
+    assert(chunk);
+    return chunk[offset];
+  }
+
+  /*!
+   * \param index Index of element
+   * \return Slot of element with specified index (its chunk is allocated if it does not exist yet)
+   */
+  tSlot& AllocateSlot(size_t index)
+  {
+    size_t chunk_index = 0;
+    size_t offset = ChunkPosition(index, chunk_index);
+    tSlot* chunk = chunks[chunk_index].load(std::memory_order_acquire);
+    if (!chunk)
+    {
+      tSlot* new_chunk = new tSlot[FIRST_CHUNK_SIZE << chunk_index]();
+      if (chunks[chunk_index].compare_exchange_strong(chunk, new_chunk))
+      {
+        chunk = new_chunk;
+      }
+      else
+      {
+        delete[] new_chunk;  // allocated concurrently
+      }
+    }
+    return chunk[offset];
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
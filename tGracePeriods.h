@@ -0,0 +1,224 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/tGracePeriods.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tGracePeriods
+ *
+ * \b tGracePeriods
+ *
+ * Tracks grace periods for deferred deletion of objects that concurrent readers might still access.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__concurrent_containers__tGracePeriods_h__
+#define __rrlib__concurrent_containers__tGracePeriods_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tNoncopyable.h"
+#include <atomic>
+#include <utility>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Grace period tracking
+/*!
+ * Tracks grace periods for deferred deletion of objects that concurrent readers might still access
+ * (epoch-based reclamation with two reader counters).
+ *
+ * Readers enclose accesses to shared objects in read sections (see tReadSection).
+ * Entering and leaving a read section are lock-free and cost one atomic increment/decrement each.
+ *
+ * Writers first unlink objects so that readers entering a read section afterwards cannot find them.
+ * Then, they retire the objects - tagged with the current epoch (GetEpoch()).
+ * Objects retired in epoch 'e' may be deleted as soon as the epoch is 'e + 2' or larger.
+ * Epochs are advanced by calling TryAdvance() - which succeeds only if all readers that started
+ * in the epoch before the current one have left their read sections.
+ * Typically, retired objects are stored in two lists - one for odd and one for even epochs.
+ * Whenever TryAdvance() succeeds, the objects in the list for the new epoch can be deleted.
+ */
+class tGracePeriods : private rrlib::util::tNoncopyable
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Read section (RAII).
+   * Objects retired while any read section that was entered before is active, are not deleted.
+   * Read sections may be copied (the copy is a read section with the same epoch).
+   */
+  class tReadSection
+  {
+  public:
+
+    /*! Creates object that is not associated with any read section */
+    tReadSection() : grace_periods(NULL), counter_index(0) {}
+
+    /*! Enters read section */
+    explicit tReadSection(const tGracePeriods& grace_periods) :
+      grace_periods(&grace_periods),
+      counter_index(grace_periods.EnterReadSection())
+    {}
+
+    tReadSection(const tReadSection& other) :
+      grace_periods(other.grace_periods),
+      counter_index(other.counter_index)
+    {
+      if (grace_periods)
+      {
+        grace_periods->readers[counter_index]++;
+      }
+    }
+
+    tReadSection& operator=(const tReadSection& other)
+    {
+      if (this != &other)
+      {
+        tReadSection copy(other);
+        std::swap(grace_periods, copy.grace_periods);
+        std::swap(counter_index, copy.counter_index);
+      }
+      return *this;
+    }
+
+    ~tReadSection()
+    {
+      if (grace_periods)
+      {
+        grace_periods->LeaveReadSection(counter_index);
+      }
+    }
+
+  private:
+
+    /*! Grace periods object that read section belongs to (NULL if none) */
+    const tGracePeriods* grace_periods;
+
+    /*! Index of reader counter that was incremented */
+    size_t counter_index;
+  };
+
+  tGracePeriods() : epoch(0)
+  {
+    readers[0] = 0;
+    readers[1] = 0;
+  }
+
+  /*!
+   * Enters read section (prefer tReadSection)
+   *
+   * \return Index of reader counter that was incremented (must be passed to LeaveReadSection())
+   */
+  size_t EnterReadSection() const
+  {
+    while (true)
+    {
+      size_t current_epoch = epoch.load();
+      readers[current_epoch & 1]++;
+      if (epoch.load() == current_epoch)
+      {
+        return current_epoch & 1;
+      }
+      readers[current_epoch & 1]--; // epoch changed concurrently: try again
+    }
+  }
+
+  /*!
+   * \return Current epoch
+   */
+  size_t GetEpoch() const
+  {
+    return epoch.load();
+  }
+
+  /*!
+   * Leaves read section (prefer tReadSection)
+   *
+   * \param counter_index Value returned by EnterReadSection()
+   */
+  void LeaveReadSection(size_t counter_index) const
+  {
+    readers[counter_index]--;
+  }
+
+  /*!
+   * Tries to advance epoch.
+   * This succeeds if all readers that started in the previous epoch have left their read sections.
+   * Lock-free. If multiple threads call this concurrently, only one of them succeeds.
+   *
+   * \return True if epoch was advanced. In this case, all objects retired two epochs before the new one may be deleted.
+   */
+  bool TryAdvance()
+  {
+    size_t current_epoch = epoch.load();
+    if (readers[(current_epoch + 1) & 1].load() != 0)
+    {
+      return false;
+    }
+    return epoch.compare_exchange_strong(current_epoch, current_epoch + 1);
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Current epoch */
+  std::atomic<size_t> epoch;
+
+  /*! Number of readers in read sections - for even and odd epochs */
+  mutable std::atomic<size_t> readers[2];
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
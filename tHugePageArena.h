@@ -0,0 +1,447 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/tHugePageArena.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tHugePageArena
+ *
+ * \b tHugePageArena
+ *
+ * Memory arena backed by (huge) pages that are pre-faulted and locked in memory.
+ * Also contains tHugePageArenaAllocator - an allocator adapter for containers and allocators in this library.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__concurrent_containers__tHugePageArena_h__
+#define __rrlib__concurrent_containers__tHugePageArena_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages.h"
+#include "rrlib/util/tNoncopyable.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tAdaptiveMutex.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Arena in pre-faulted, locked (huge page) memory
+/*!
+ * Reserves a fixed amount of memory on construction:
+ * it tries to map explicit huge pages (MAP_HUGETLB) first.
+ * If no huge pages are available, ordinary memory is mapped (aligned to huge page size)
+ * and transparent huge pages are requested with madvise(MADV_HUGEPAGE).
+ * All memory is pre-faulted and locked with mlock(), so that allocating from
+ * the arena does not cause page faults later (e.g. in real-time threads).
+ * Huge pages also reduce TLB misses when following pointers between elements (e.g. next_queueable chains).
+ *
+ * Allocations are rounded up to powers of two (at least cMIN_BLOCK_SIZE bytes, which is also their alignment).
+ * Deallocated blocks are kept in free lists and reused for allocations of the same size class.
+ * Memory is returned to the system when the arena is deleted - so the arena must outlive
+ * everything allocated from it.
+ *
+ * Allocating and deallocating is thread-safe and does not involve system calls.
+ */
+class tHugePageArena : private rrlib::util::tNoncopyable
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Minimum block size and alignment of allocated memory (cache line size) */
+  enum { cMIN_BLOCK_SIZE = 64 };
+
+  /*! Capacity of arena returned by Default() */
+  enum { cDEFAULT_CAPACITY = 32 * 1024 * 1024 };
+
+  /*! Information on arena and its memory */
+  struct tStatistics
+  {
+    /*! Capacity of arena in bytes */
+    size_t capacity;
+
+    /*! Bytes handed out from arena so far (including blocks currently in free lists) */
+    size_t used;
+
+    /*! Bytes of arena that are backed by (explicit or transparent) huge pages */
+    size_t huge_page_bytes;
+
+    /*! True, if arena is backed by explicit huge pages (MAP_HUGETLB) */
+    bool explicit_huge_pages;
+
+    /*! True, if arena memory is locked in memory */
+    bool locked;
+  };
+
+  /*!
+   * \param capacity Capacity of arena in bytes (is rounded up to multiple of huge page size)
+   */
+  explicit tHugePageArena(size_t capacity) :
+    memory(NULL),
+    mapping(NULL),
+    mapping_size(0),
+    capacity(0),
+    used(0),
+    explicit_huge_pages(false),
+    locked(false),
+    mutex(),
+    free_lists()
+  {
+    const size_t huge_page_size = HugePageSize();
+    capacity = ((capacity + huge_page_size - 1) / huge_page_size) * huge_page_size;
+
+#ifdef MAP_HUGETLB
+    mapping = mmap(NULL, capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE, -1, 0);
+    if (mapping != MAP_FAILED)
+    {
+      explicit_huge_pages = true;
+      mapping_size = capacity;
+      memory = static_cast<char*>(mapping);
+    }
+#endif
+    if (!explicit_huge_pages)
+    {
+      // Over-allocate so that memory can be aligned to huge page boundary (prerequisite for transparent huge pages)
+      mapping_size = capacity + huge_page_size;
+      mapping = mmap(NULL, mapping_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (mapping == MAP_FAILED)
+      {
+        mapping = NULL;
+        throw std::bad_alloc();
+      }
+      memory = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(mapping) + huge_page_size - 1) & ~(static_cast<uintptr_t>(huge_page_size) - 1));
+#ifdef MADV_HUGEPAGE
+      if (madvise(memory, capacity, MADV_HUGEPAGE))
+      {
+        RRLIB_LOG_PRINT(DEBUG, "Transparent huge pages are not available.");
+      }
+#endif
+    }
+    this->capacity = capacity;
+
+    // Pre-fault memory (MAP_POPULATE is only a hint - and not used for ordinary pages, so that they are faulted in after madvise)
+    const size_t page_size = sysconf(_SC_PAGESIZE);
+    for (size_t i = 0; i < capacity; i += page_size)
+    {
+      memory[i] = 0;
+    }
+
+    locked = (mlock(memory, capacity) == 0);
+    if (!locked)
+    {
+      RRLIB_LOG_PRINT(WARNING, "Could not lock arena memory (", capacity, " bytes). Check RLIMIT_MEMLOCK. Memory may be paged out.");
+    }
+  }
+
+  ~tHugePageArena()
+  {
+    if (mapping)
+    {
+      if (locked)
+      {
+        munlock(memory, capacity);
+      }
+      munmap(mapping, mapping_size);
+    }
+  }
+
+  /*!
+   * Allocates memory from arena
+   *
+   * \param size Size of memory block in bytes
+   * \return Pointer to memory block (aligned to cMIN_BLOCK_SIZE)
+   * \throw std::bad_alloc if arena is exhausted
+   */
+  void* Allocate(size_t size)
+  {
+    size_t size_class = SizeClass(size);
+    tAdaptiveMutex::tLock lock(mutex);
+    tFreeBlock* block = free_lists[size_class];
+    if (block)
+    {
+      free_lists[size_class] = block->next;
+      return block;
+    }
+    size_t block_size = BlockSize(size_class);
+    if (block_size > capacity - used)
+    {
+      RRLIB_LOG_PRINT(ERROR, "Arena exhausted (capacity ", capacity, " bytes, ", used, " used, ", block_size, " requested).");
+      throw std::bad_alloc();
+    }
+    void* result = memory + used;
+    used += block_size;
+    return result;
+  }
+
+  /*!
+   * Returns memory block to arena
+   *
+   * \param pointer Pointer to memory block obtained via Allocate()
+   * \param size Size that was passed to Allocate()
+   */
+  void Deallocate(void* pointer, size_t size)
+  {
+    size_t size_class = SizeClass(size);
+    tAdaptiveMutex::tLock lock(mutex);
+    tFreeBlock* block = static_cast<tFreeBlock*>(pointer);
+    block->next = free_lists[size_class];
+    free_lists[size_class] = block;
+  }
+
+  /*!
+   * \return Default arena with cDEFAULT_CAPACITY (created on first call)
+   */
+  static tHugePageArena& Default()
+  {
+    static tHugePageArena arena(cDEFAULT_CAPACITY);
+    return arena;
+  }
+
+  /*!
+   * \return Information on arena - including actual huge page usage
+   */
+  tStatistics GetStatistics()
+  {
+    tStatistics result;
+    {
+      tAdaptiveMutex::tLock lock(mutex);
+      result.used = used;
+    }
+    result.capacity = capacity;
+    result.explicit_huge_pages = explicit_huge_pages;
+    result.locked = locked;
+    result.huge_page_bytes = explicit_huge_pages ? capacity : TransparentHugePageBytes();
+    return result;
+  }
+
+  /*!
+   * \return Size of huge pages on this system (2 MB if it cannot be determined)
+   */
+  static size_t HugePageSize()
+  {
+    size_t result = 2 * 1024 * 1024;
+    FILE* file = fopen("/proc/meminfo", "r");
+    if (file)
+    {
+      char line[256];
+      while (fgets(line, sizeof(line), file))
+      {
+        unsigned long kilobytes = 0;
+        if (sscanf(line, "Hugepagesize: %lu kB", &kilobytes) == 1 && kilobytes)
+        {
+          result = kilobytes * 1024;
+          break;
+        }
+      }
+      fclose(file);
+    }
+    return result;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Number of size classes (block sizes cMIN_BLOCK_SIZE * 2^i) */
+  enum { cSIZE_CLASSES = 48 };
+
+  /*! Free block in free list */
+  struct tFreeBlock
+  {
+    tFreeBlock* next;
+  };
+
+  /*! Start of (aligned) arena memory */
+  char* memory;
+
+  /*! Mapped memory (may contain some unused memory before and after 'memory') */
+  void* mapping;
+
+  /*! Size of mapped memory */
+  size_t mapping_size;
+
+  /*! Capacity of arena */
+  size_t capacity;
+
+  /*! Bytes handed out from arena so far */
+  size_t used;
+
+  /*! True, if arena is backed by explicit huge pages */
+  bool explicit_huge_pages;
+
+  /*! True, if memory is locked */
+  bool locked;
+
+  /*! Mutex for free lists and 'used' */
+  tAdaptiveMutex mutex;
+
+  /*! Free lists for all size classes */
+  tFreeBlock* free_lists[cSIZE_CLASSES];
+
+  static size_t BlockSize(size_t size_class)
+  {
+    return static_cast<size_t>(cMIN_BLOCK_SIZE) << size_class;
+  }
+
+  static size_t SizeClass(size_t size)
+  {
+    size_t size_class = 0;
+    while (BlockSize(size_class) < size)
+    {
+      size_class++;
+    }
+    return size_class;
+  }
+
+  /*!
+   * \return Bytes of arena backed by transparent huge pages (AnonHugePages in /proc/self/smaps)
+   */
+  size_t TransparentHugePageBytes()
+  {
+    size_t result = 0;
+    FILE* file = fopen("/proc/self/smaps", "r");
+    if (!file)
+    {
+      return 0;
+    }
+    char line[256];
+    bool in_mapping = false;
+    while (fgets(line, sizeof(line), file))
+    {
+      unsigned long start = 0, end = 0;
+      if (sscanf(line, "%lx-%lx ", &start, &end) == 2)
+      {
+        in_mapping = start < reinterpret_cast<uintptr_t>(memory) + capacity && end > reinterpret_cast<uintptr_t>(memory);
+        continue;
+      }
+      unsigned long kilobytes = 0;
+      if (in_mapping && sscanf(line, "AnonHugePages: %lu kB", &kilobytes) == 1)
+      {
+        result += kilobytes * 1024;
+      }
+    }
+    fclose(file);
+    return result;
+  }
+};
+
+//! Allocator adapter for tHugePageArena
+/*!
+ * Standard allocator that allocates from a tHugePageArena.
+ * Can be used as TAllocator of ArrayChunkBased set storage and of tSlabAllocator.
+ * Default-constructed allocators use tHugePageArena::Default().
+ *
+ * \tparam T Type of objects to allocate
+ */
+template <typename T>
+class tHugePageArenaAllocator
+{
+  template <typename U>
+  friend class tHugePageArenaAllocator;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef T value_type;
+
+  template <typename U>
+  struct rebind
+  {
+    typedef tHugePageArenaAllocator<U> other;
+  };
+
+  tHugePageArenaAllocator() : arena(&tHugePageArena::Default()) {}
+
+  explicit tHugePageArenaAllocator(tHugePageArena& arena) : arena(&arena) {}
+
+  template <typename U>
+  tHugePageArenaAllocator(const tHugePageArenaAllocator<U>& other) : arena(other.arena) {}
+
+  T* allocate(size_t n)
+  {
+    return static_cast<T*>(arena->Allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T* pointer, size_t n)
+  {
+    arena->Deallocate(pointer, n * sizeof(T));
+  }
+
+  template <typename U>
+  bool operator==(const tHugePageArenaAllocator<U>& other) const
+  {
+    return arena == other.arena;
+  }
+
+  template <typename U>
+  bool operator!=(const tHugePageArenaAllocator<U>& other) const
+  {
+    return arena != other.arena;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Arena to allocate from */
+  tHugePageArena* arena;
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
@@ -0,0 +1,279 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/tIndexedArena.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tIndexedArena
+ *
+ * \b tIndexedArena
+ *
+ * Arena for elements derived from tQueueable<tQueueability::INDEXED>
+ * that are addressed by 32-bit indices.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__concurrent_containers__tIndexedArena_h__
+#define __rrlib__concurrent_containers__tIndexedArena_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tQueueable.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Arena for index-addressed objects
+/*!
+ * Allocates elements of type T from one contiguous array of CAPACITY blocks
+ * (allocated on first use and never returned to the system - so memory is type-stable).
+ * Blocks are addressed by their 32-bit index in this array.
+ *
+ * Elements created with this arena can be enqueued in tQueue<tIndexedArena<T>::tPointer, ...>.
+ * The queue links them via 32-bit indices.
+ *
+ * Free blocks are managed in a lock-free stack - linked via the elements' queue links.
+ * Its head contains index and a 32-bit stamp in a single 64-bit word.
+ *
+ * \tparam T Type of objects to allocate
+ * \tparam CAPACITY Maximum number of objects
+ * \tparam TAllocator Allocator for block array (rebound to char - e.g. tHugePageArenaAllocator)
+ */
+template <typename T, size_t CAPACITY = 65536, typename TAllocator = std::allocator<char>>
+class tIndexedArena
+{
+  static_assert(CAPACITY > 0 && CAPACITY < 0xFFFFFFF0u, "Capacity must be representable with 32-bit indices (a few indices are reserved)");
+  static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types are not supported");
+  static_assert(std::is_base_of<queue::tQueueableIndexed, T>::value, "T must be derived from tQueueable<tQueueability::INDEXED>");
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Deleter for unique pointers to objects allocated with this arena */
+  struct tDeleter
+  {
+    /*! Arena that elements are allocated from (used by queue implementations) */
+    typedef tIndexedArena tArena;
+
+    void operator()(T* object) const
+    {
+      object->~T();
+      Deallocate(object);
+    }
+  };
+
+  /*! Unique pointer to object allocated with this arena */
+  typedef std::unique_ptr<T, tDeleter> tPointer;
+
+  static_assert(sizeof(tPointer) == sizeof(void*), "Deleter must not increase size of unique pointer");
+
+  /*!
+   * Allocates memory for an object of type T
+   * (prefer Create())
+   *
+   * \return Pointer to memory block
+   * \throw std::bad_alloc if arena is exhausted
+   */
+  static void* Allocate()
+  {
+    tStorage& storage = Storage();
+    uint64_t head = storage.free_blocks.load();
+    while (Index(head) != queue::tQueueableIndexed::cNULL_INDEX)
+    {
+      uint32_t next = FreeLink(Index(head))->load(std::memory_order_relaxed);  // block memory stays valid
+      if (storage.free_blocks.compare_exchange_weak(head, Pack(next, Stamp(head) + 1)))
+      {
+        return Block(Index(head));
+      }
+    }
+
+    uint32_t index = storage.unused_blocks.load(std::memory_order_relaxed);
+    do
+    {
+      if (index >= CAPACITY)
+      {
+        throw std::bad_alloc();
+      }
+    }
+    while (!storage.unused_blocks.compare_exchange_weak(index, index + 1, std::memory_order_relaxed));
+    return Block(index);
+  }
+
+  /*!
+   * Creates object
+   *
+   * \param args Arguments for T's constructor
+   * \return Unique pointer to created object
+   */
+  template <typename ... TArgs>
+  static tPointer Create(TArgs && ... args)
+  {
+    void* memory = Allocate();
+    try
+    {
+      return tPointer(new(memory) T(std::forward<TArgs>(args)...));
+    }
+    catch (...)
+    {
+      Deallocate(memory);
+      throw;
+    }
+  }
+
+  /*!
+   * Returns memory block to arena (object must have been destructed already)
+   *
+   * \param memory Memory block obtained via Allocate()
+   */
+  static void Deallocate(void* memory)
+  {
+    uint32_t index = GetIndex(static_cast<T*>(memory));
+    std::atomic<uint32_t>* link = FreeLink(index);
+    std::atomic<uint64_t>& free_blocks = Storage().free_blocks;
+    uint64_t head = free_blocks.load();
+    do
+    {
+      link->store(Index(head), std::memory_order_relaxed);
+    }
+    while (!free_blocks.compare_exchange_weak(head, Pack(index, Stamp(head) + 1)));
+  }
+
+  /*!
+   * \param index Index of object
+   * \return Object with specified index
+   */
+  static T* Element(uint32_t index)
+  {
+    return reinterpret_cast<T*>(Block(index));
+  }
+
+  /*!
+   * \param element Object allocated from this arena
+   * \return Index of object
+   */
+  static uint32_t GetIndex(const T* element)
+  {
+    return static_cast<uint32_t>((reinterpret_cast<const char*>(element) - Storage().blocks) / cBLOCK_SIZE);
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Size of each block (multiple of max_align_t's alignment) */
+  enum { cBLOCK_SIZE = ((sizeof(T) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t)) * alignof(std::max_align_t) };
+
+  /*! Block array is allocated as char array */
+  typedef typename std::allocator_traits<TAllocator>::template rebind_alloc<char> tBlockAllocator;
+
+  /*! Arena state (shared by all threads) */
+  struct tStorage
+  {
+    tStorage() :
+      blocks(NULL),
+      free_blocks(Pack(queue::tQueueableIndexed::cNULL_INDEX, 0)),
+      unused_blocks(0)
+    {
+      tBlockAllocator allocator;
+      blocks = std::allocator_traits<tBlockAllocator>::allocate(allocator, CAPACITY * cBLOCK_SIZE);
+    }
+
+    /*! Block array */
+    char* blocks;
+
+    /*! Top of stack of free blocks (index in lower 32 bits, stamp in upper 32 bits) */
+    std::atomic<uint64_t> free_blocks;
+
+    /*! Blocks with this index or larger have never been used */
+    std::atomic<uint32_t> unused_blocks;
+  };
+
+  static tStorage& Storage()
+  {
+    static tStorage storage;
+    return storage;
+  }
+
+  static char* Block(uint32_t index)
+  {
+    return Storage().blocks + static_cast<size_t>(index) * cBLOCK_SIZE;
+  }
+
+  /*! Link to next free block (free blocks reuse the element's queue link - which is only accessed atomically) */
+  static std::atomic<uint32_t>* FreeLink(uint32_t index)
+  {
+    return &static_cast<queue::tQueueableIndexed*>(Element(index))->next_index;
+  }
+
+  static uint32_t Index(uint64_t packed)
+  {
+    return static_cast<uint32_t>(packed);
+  }
+
+  static uint32_t Stamp(uint64_t packed)
+  {
+    return static_cast<uint32_t>(packed >> 32);
+  }
+
+  static uint64_t Pack(uint32_t index, uint32_t stamp)
+  {
+    return (static_cast<uint64_t>(stamp) << 32) | index;
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
@@ -0,0 +1,202 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/tMap.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tMap
+ *
+ * \b tMap
+ *
+ * Map from keys to values.
+ * Can be used with different storage policies - like tSet.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__concurrent_containers__tMap_h__
+#define __rrlib__concurrent_containers__tMap_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tSet.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Concurrent map
+/*!
+ * Map from keys to values.
+ * Can be used with different storage policies that offer different levels of concurrency.
+ * With HashTable storage, lookups are lock-free and can therefore be done with real-time threads.
+ *
+ * \tparam TKey Type of keys. Must be copyable and comparable with '=='. Keys of entries are never modified.
+ * \tparam TValue Type of values. TValue must be suitable for std::atomic<TValue>
+ *                (as values may be replaced concurrently to lookups)
+ * \tparam TMutex Type of mutex to use for non-concurrent map operations (typically modifying calls - with HashTable storage, one mutex per lock stripe).
+ *                May be set to tNoMutex if concurrent calls to these operations cannot occur.
+ *                Otherwise it should be set to tMutex (or tAdaptiveMutex).
+ * \tparam TStoragePolicy Determines map implementation and which calls may be executed concurrently.
+ * \tparam TNullElement Value that is returned for keys that are not in map. It may not be stored in map.
+ *                      Type needs constant 'cNULL_ELEMENT' that can be casted to type TValue.
+ */
+template <typename TKey, typename TValue, typename TMutex, class TStoragePolicy, typename TNullElement = NullElementDefault<TValue>>
+class tMap : TStoragePolicy::template tInstance<TKey, TValue, TMutex, TNullElement>
+{
+
+  typedef typename TStoragePolicy::template tInstance<TKey, TValue, TMutex, TNullElement> tStoragePolicy;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Removes all entries from map
+   */
+  void Clear()
+  {
+    tStoragePolicy::Clear();
+  }
+
+  /*!
+   * \param key Key to look for
+   * \return True if map contains an entry with this key
+   */
+  bool Contains(const TKey& key) const
+  {
+    return tStoragePolicy::Contains(key);
+  }
+
+  /*!
+   * \return True if map is empty
+   */
+  bool Empty() const
+  {
+    return tStoragePolicy::Empty();
+  }
+
+  /*!
+   * Calls function for every entry in map.
+   * Entries that are in the map during the whole call are visited exactly once.
+   * Entries that are added or removed concurrently might or might not be visited.
+   *
+   * \param function Function to call with key and value of each entry (signature: void (const TKey&, TValue))
+   */
+  template <typename TFunction>
+  void ForEach(TFunction function) const
+  {
+    tStoragePolicy::ForEach(function);
+  }
+
+  /*!
+   * \param key Key to look up
+   * \return Value of entry with this key (null element if there is none)
+   */
+  TValue Get(const TKey& key) const
+  {
+    return tStoragePolicy::Get(key);
+  }
+
+  /*!
+   * Adds entry to map - if map does not contain an entry with the specified key yet
+   *
+   * \param key Key of entry
+   * \param value Value of entry (may not be the null element - such calls are ignored)
+   * \return True if entry was added
+   */
+  bool Insert(const TKey& key, const TValue& value)
+  {
+    if (value == static_cast<TValue>(TNullElement::cNULL_ELEMENT))
+    {
+      RRLIB_LOG_PRINT(ERROR, "The 'null element' may not be stored in map. Ignoring. Please fix your code.");
+      return false;
+    }
+    return tStoragePolicy::Insert(key, value);
+  }
+
+  /*!
+   * Removes entry from map
+   *
+   * \param key Key of entry to remove
+   * \return Value of removed entry (null element if map did not contain key)
+   */
+  TValue Remove(const TKey& key)
+  {
+    return tStoragePolicy::Remove(key);
+  }
+
+  /*!
+   * Adds entry to map - or replaces value of existing entry with the specified key
+   *
+   * \param key Key of entry
+   * \param value New value of entry (may not be the null element - such calls are ignored)
+   * \return Previous value of entry (null element if map did not contain key - or if value is the null element)
+   */
+  TValue Set(const TKey& key, const TValue& value)
+  {
+    if (value == static_cast<TValue>(TNullElement::cNULL_ELEMENT))
+    {
+      RRLIB_LOG_PRINT(ERROR, "The 'null element' may not be stored in map. Ignoring. Please fix your code.");
+      return TNullElement::cNULL_ELEMENT;
+    }
+    return tStoragePolicy::Set(key, value);
+  }
+
+  /*!
+   * \return Number of entries in map
+   */
+  size_t Size() const
+  {
+    return tStoragePolicy::Size();
+  }
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#include "rrlib/concurrent_containers/policies/map/storage/HashTable.h"
+
+#endif
@@ -29,7 +29,8 @@
  *
  * \b tQueue
  *
- * Concurrent non-blocking Queue.
+ * Concurrent non-blocking Queue
+ * (with one opt-in exception - see class documentation).
  *
  */
 //----------------------------------------------------------------------
@@ -74,8 +75,19 @@ namespace concurrent_containers
  *
  * Using this queue is most efficient, when using std::unique_ptr<U> as type T, with U
  * derived from tQueueable<...>.
- * TODO: Otherwise, objects are placed in queue nodes that need to be managed separately.
+ * Otherwise, objects are placed in queue nodes that are taken from a pool managed by the queue
+ * (so enqueueing does not allocate memory in steady state).
+ * Trivially copyable values (e.g. integers) are stored inline in linked segments
+ * (currently only in non-bounded queues with tDequeueMode::FIFO or tDequeueMode::FIFO_FAST).
+ * Raw pointers U* (U derived from tQueueable<...> - except tQueueability::INDEXED) can be used for objects whose lifetime is managed
+ * elsewhere (e.g. static tables): such elements are never deleted by queues or fragments.
+ * Note that the last enqueued element may remain in queue (see cMINIMUM_ELEMENTS_IN_QEUEUE).
+ * Objects that are enqueued in several queues at the same time can be derived from tSharedQueueable<...>
+ * and enqueued via tQueueableSharedPointer<U, SLOT> (one link slot per queue).
  * Due to the use of universal queue node objects, sizeof(T) must not be larger than sizeof(void*).
+ * Concurrent, bounded queues with tDequeueMode::ALL require U to be derived from tQueueable<FULL> or tQueueable<FULL_OPTIMIZED>.
+ * If U specializes tAllowBlockingBoundedFragmentQueue<U>, U derived from tQueueable<MOST> or tQueueable<MOST_OPTIMIZED> is accepted as well:
+ * this queue is then NOT non-blocking, as Enqueue() and DequeueAll() lock a mutex (threads may be suspended while waiting for it).
  *
  * \tparam T Enqueued elements. Ideally, std::unique_ptr<U> with with U derived from tQueueable<...>
  * \tparam CONCURRENCY Concurrency that queue should support
@@ -179,7 +191,8 @@ public:
    * Due to concurrency, however, the queue may temporarily contain more elements.
    * It is guaranteed that elements are discarded only if the queue length exceeds the specified 'guiding value'.
    *
-   * \param max_length New 'guiding value' for maximum queue length (max. 500000 for concurrent queues)
+   * \param max_length New 'guiding value' for maximum queue length
+   *                   (max. 500000 for concurrent queues - unless elements have tQueueability::INDEXED)
    */
   template <bool ENABLE = BOUNDED>
   inline void SetMaxLength(typename std::enable_if<ENABLE, int>::type max_length)
@@ -41,6 +41,7 @@
 //----------------------------------------------------------------------
 #include "rrlib/util/tNoncopyable.h"
 #include <atomic>
+#include <type_traits>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
@@ -74,14 +75,16 @@ enum class tQueueability
 
   /*!
    * Object can be used in most queues.
-   * Currently, this excludes concurrent, bounded queues with tDequeueMode::ALL.
+   * Currently, this excludes concurrent, bounded queues with tDequeueMode::ALL
+   * (unless blocking is acceptable - see tAllowBlockingBoundedFragmentQueue).
    * (has size of 1 pointer)
    */
   MOST,
 
   /*!
    * Object can be used in most queues.
-   * Currently, this excludes concurrent, bounded queues with tDequeueMode::ALL.
+   * Currently, this excludes concurrent, bounded queues with tDequeueMode::ALL
+   * (unless blocking is acceptable - see tAllowBlockingBoundedFragmentQueue).
    * It has an additional single-threaded pointer that leads to higher
    * computational efficiency in single-threaded queues and queue fragments
    * (has size of 2 pointers (MOST + SINGLE_THREADED)
@@ -100,9 +103,29 @@ enum class tQueueability
    * computational efficiency in single-threaded queues and queue fragments
    * (has size of 3 pointers (FULL + SINGLE_THREADED)
    */
-  FULL_OPTIMIZED
+  FULL_OPTIMIZED,
+
+  /*!
+   * Object is allocated from a tIndexedArena and linked via 32-bit indices
+   * instead of pointers. Such objects can be used in FIFO queues only (bounded or non-bounded).
+   * ABA stamps of these queues have 32 bits - so bounded queues are not affected by stamp wraparound.
+   * (has size of 32 bits)
+   */
+  INDEXED
 };
 
+/*!
+ * Concurrent, bounded queues with tDequeueMode::ALL require objects derived from tQueueable<FULL> or tQueueable<FULL_OPTIMIZED>.
+ * Specializing this trait with std::true_type for a type T derived from tQueueable<MOST> or tQueueable<MOST_OPTIMIZED>
+ * allows using T in such queues nevertheless. These queues, however, lock a mutex in Enqueue() and DequeueAll() -
+ * so they are not non-blocking and threads may be suspended while waiting.
+ *
+ * \tparam T Type of queueable object
+ */
+template <typename T>
+struct tAllowBlockingBoundedFragmentQueue : std::false_type
+{};
+
 
 //----------------------------------------------------------------------
 // Class declaration
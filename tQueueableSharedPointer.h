@@ -0,0 +1,310 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/tQueueableSharedPointer.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tQueueableSharedPointer
+ *
+ * \b tQueueableSharedPointer
+ *
+ * Intrusive reference-counted pointer to objects that can be in several queues at once
+ * (base class tSharedQueueable provides one link slot per queue).
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__concurrent_containers__tQueueableSharedPointer_h__
+#define __rrlib__concurrent_containers__tQueueableSharedPointer_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tQueueable.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+namespace queue
+{
+
+/*! Link slot with index SLOT (each slot is a distinct base class) */
+template <size_t SLOT, tQueueability QUEUEABILITY>
+class tQueueLinkSlot : public tQueueable<QUEUEABILITY>
+{};
+
+/*! Link slots 0 to SLOTS - 1 */
+template <size_t SLOTS, tQueueability QUEUEABILITY>
+class tQueueLinkSlots : public tQueueLinkSlots < SLOTS - 1, QUEUEABILITY >, public tQueueLinkSlot < SLOTS - 1, QUEUEABILITY >
+{};
+
+template <tQueueability QUEUEABILITY>
+class tQueueLinkSlots<0, QUEUEABILITY>
+{};
+
+}
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Base class for objects that can be in several queues at once
+/*!
+ * Objects derived from this class can be enqueued in up to SLOTS queues at the same time
+ * (using tQueue<tQueueableSharedPointer<T, SLOT>, ...>) - without being copied:
+ * each slot contains the links of one queue - and each queue holds a reference.
+ *
+ * An object may be in at most one queue per slot at a time. Typically, every consumer queue
+ * that objects are distributed to uses its own slot.
+ *
+ * \tparam SLOTS Number of link slots
+ * \tparam QUEUEABILITY Queueability of each slot (tQueueability::FULL is required for lock-free, bounded queues with tDequeueMode::ALL)
+ */
+template <size_t SLOTS, tQueueability QUEUEABILITY = tQueueability::MOST>
+class tSharedQueueable : public queue::tQueueLinkSlots<SLOTS, QUEUEABILITY>
+{
+  static_assert(SLOTS > 0, "At least one slot is required");
+  static_assert(QUEUEABILITY != tQueueability::SINGLE_THREADED && QUEUEABILITY != tQueueability::INDEXED, "Slots must be usable in concurrent, pointer-linked queues");
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Number of link slots */
+  enum { cSLOTS = SLOTS };
+
+  /*! Type of link slot with index SLOT */
+  template <size_t SLOT>
+  using tLinkSlot = queue::tQueueLinkSlot<SLOT, QUEUEABILITY>;
+
+  tSharedQueueable() : shared_queueable_references(0) {}
+
+  /*!
+   * Number of tQueueableSharedPointer instances (and queues) referencing object
+   * (internal - only to be used by tQueueableSharedPointer)
+   */
+  std::atomic<size_t> shared_queueable_references;
+};
+
+//! Shared pointer for queues
+/*!
+ * Intrusive reference-counted pointer to objects of type T (derived from tSharedQueueable).
+ * Has the size of a raw pointer.
+ *
+ * tQueue<tQueueableSharedPointer<T, SLOT>, ...> uses link slot SLOT of enqueued objects.
+ * Pointers can be converted to pointers with other slots - so an object can be
+ * distributed to several queues at the cost of one reference counter increment per queue:
+ *
+ *   queue_a.Enqueue(tQueueableSharedPointer<T, 0>(pointer));
+ *   queue_b.Enqueue(tQueueableSharedPointer<T, 1>(pointer));
+ *
+ * The object is deleted when the last pointer referencing it is destructed or reset.
+ *
+ * \tparam T Type of object (derived from tSharedQueueable)
+ * \tparam SLOT Link slot used in queues
+ */
+template <typename T, size_t SLOT = 0>
+class tQueueableSharedPointer
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Link slot type */
+  typedef typename T::template tLinkSlot<SLOT> tLinkSlot;
+
+  /*! Deleter for queue references (releases reference) */
+  struct tQueueReferenceDeleter
+  {
+    void operator()(tLinkSlot* slot) const
+    {
+      FromQueueReference(tQueueReference(slot));
+    }
+  };
+
+  /*!
+   * Reference held by queue (internal - only to be used by queue implementations)
+   * (unique pointer to link slot, so that the intrusive queue implementations can be used)
+   */
+  typedef std::unique_ptr<tLinkSlot, tQueueReferenceDeleter> tQueueReference;
+
+  tQueueableSharedPointer() : object(NULL) {}
+
+  /*!
+   * \param object Object to reference (pointers created with this constructor must not reference objects that are referenced already)
+   */
+  explicit tQueueableSharedPointer(T* object) : object(object)
+  {
+    AddReference();
+  }
+
+  tQueueableSharedPointer(const tQueueableSharedPointer& other) : object(other.object)
+  {
+    AddReference();
+  }
+
+  tQueueableSharedPointer(tQueueableSharedPointer && other) : object(other.object)
+  {
+    other.object = NULL;
+  }
+
+  /*! Converts pointer with other slot */
+  template <size_t OTHER_SLOT>
+  tQueueableSharedPointer(const tQueueableSharedPointer<T, OTHER_SLOT>& other) : object(other.get())
+  {
+    AddReference();
+  }
+
+  ~tQueueableSharedPointer()
+  {
+    reset();
+  }
+
+  tQueueableSharedPointer& operator=(tQueueableSharedPointer other)
+  {
+    std::swap(object, other.object);
+    return *this;
+  }
+
+  /*!
+   * Converts queue reference back to pointer (internal - only to be used by queue implementations)
+   *
+   * \param reference Queue reference (may be empty)
+   * \return Pointer that took over reference
+   */
+  static tQueueableSharedPointer FromQueueReference(tQueueReference && reference)
+  {
+    tQueueableSharedPointer result;
+    result.object = static_cast<T*>(reference.release());
+    return result;
+  }
+
+  /*!
+   * \return Raw pointer to object
+   */
+  T* get() const
+  {
+    return object;
+  }
+
+  /*!
+   * \return Number of pointers (and queues) referencing object (0 if this is a null pointer)
+   */
+  size_t GetReferenceCount() const
+  {
+    return object ? object->shared_queueable_references.load() : 0;
+  }
+
+  /*!
+   * Releases reference (deletes object if this was the last one)
+   */
+  void reset()
+  {
+    if (object && object->shared_queueable_references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+      delete object;
+    }
+    object = NULL;
+  }
+
+  /*!
+   * Converts pointer to queue reference (internal - only to be used by queue implementations)
+   * (this pointer is reset)
+   */
+  tQueueReference ToQueueReference()
+  {
+    T* result = object;
+    object = NULL;
+    return tQueueReference(result);
+  }
+
+  T& operator*() const
+  {
+    return *object;
+  }
+
+  T* operator->() const
+  {
+    return object;
+  }
+
+  explicit operator bool() const
+  {
+    return object != NULL;
+  }
+
+  bool operator==(const tQueueableSharedPointer& other) const
+  {
+    return object == other.object;
+  }
+
+  bool operator!=(const tQueueableSharedPointer& other) const
+  {
+    return object != other.object;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  static_assert(SLOT < T::cSLOTS, "T does not have this slot");
+
+  /*! Referenced object */
+  T* object;
+
+  void AddReference()
+  {
+    if (object)
+    {
+      object->shared_queueable_references.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
@@ -0,0 +1,233 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/tRecyclingPool.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tRecyclingPool
+ *
+ * \b tRecyclingPool
+ *
+ * Pool of queueable elements that are returned to the (producer) thread
+ * that owns the pool - instead of being deleted.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__concurrent_containers__tRecyclingPool_h__
+#define __rrlib__concurrent_containers__tRecyclingPool_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tNoncopyable.h"
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tQueueFragment.h"
+#include "rrlib/concurrent_containers/queue/tRecyclingChannel.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Base class for elements of tRecyclingPool
+/*!
+ * Queueable element that remembers the pool it was created by.
+ *
+ * \tparam QUEUEABILITY Queueability of element (SINGLE_THREADED is not supported, as return channels are concurrent)
+ */
+template <tQueueability QUEUEABILITY = tQueueability::MOST>
+class tRecyclable : public tQueueable<QUEUEABILITY>, public queue::tRecyclableBase
+{
+  static_assert(QUEUEABILITY != tQueueability::SINGLE_THREADED, "Recyclable elements must be usable in concurrent queues");
+};
+
+//! Pool of recyclable queueable elements
+/*!
+ * Pool owned by a single (producer) thread.
+ * Elements obtained from the pool are passed to consumers - typically via
+ * tQueue<tRecyclingPool<T>::tPointer, ...>.
+ * When consumers drop an element (or the fragment containing it), the element is not deleted:
+ * it is pushed to the lock-free return channel of its pool - reusing the element's intrusive queue link.
+ * The producer then reuses its own cache-warm elements without involving the memory allocator.
+ *
+ * Elements are returned as they are - they are not destructed or reset.
+ * The pool's deleter is an empty class, so unique pointers have the size of a raw pointer (as required by tQueue).
+ *
+ * Elements may outlive their pool: elements returned after the pool has been deleted are deleted.
+ *
+ * \tparam T Type of elements. Must be derived from tRecyclable<...>.
+ */
+template <typename T>
+class tRecyclingPool : private rrlib::util::tNoncopyable
+{
+  static_assert(std::is_base_of<queue::tRecyclableBase, T>::value, "T must be derived from tRecyclable");
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Deleter that returns elements to their pool */
+  struct tDeleter
+  {
+    void operator()(T* element) const
+    {
+      static_cast<queue::tRecyclableBase*>(element)->origin->Return(element, element, 1);
+    }
+  };
+
+  /*! Unique pointer to element of pool */
+  typedef std::unique_ptr<T, tDeleter> tPointer;
+
+  static_assert(sizeof(tPointer) == sizeof(void*), "Deleter must not increase size of unique pointer");
+
+  tRecyclingPool() :
+    channel(new queue::tRecyclingChannel(&DeleteElement)),
+    unused(NULL)
+  {}
+
+  ~tRecyclingPool()
+  {
+    channel->RemoveReferences(channel->DeleteChain(unused));
+    channel->Close();
+  }
+
+  /*!
+   * Creates new element that belongs to this pool
+   * (only to be called by thread owning the pool)
+   *
+   * \param args Arguments for T's constructor
+   * \return Unique pointer to created element
+   */
+  template <typename ... TArgs>
+  tPointer Create(TArgs && ... args)
+  {
+    T* element = new T(std::forward<TArgs>(args)...);
+    static_cast<queue::tRecyclableBase*>(element)->origin = channel;
+    channel->AddReference();
+    return tPointer(element);
+  }
+
+  /*!
+   * Obtains unused element from pool
+   * (only to be called by thread owning the pool)
+   *
+   * \return Element that was returned to pool (null pointer if there is none - Create() may be called in this case)
+   */
+  tPointer GetUnused()
+  {
+    if (!unused)
+    {
+      unused = channel->TakeAll();
+      if (!unused)
+      {
+        return tPointer();
+      }
+    }
+    queue::tQueueableMost* result = unused;
+    unused = result->next_queueable.load(std::memory_order_relaxed);
+    result->next_queueable.store(NULL, std::memory_order_relaxed);
+    return tPointer(static_cast<T*>(result));
+  }
+
+  /*!
+   * Returns all elements in queue fragment to their pools.
+   * Consecutive elements from the same pool are returned with a single atomic operation
+   * (so a fragment containing elements of a single pool is spliced into the return channel at once).
+   *
+   * \param fragment Fragment whose elements to return
+   */
+  static void Recycle(tQueueFragment<tPointer>& fragment)
+  {
+    queue::tRecyclingChannel* run_channel = NULL;
+    queue::tQueueableMost* run_first = NULL;
+    queue::tQueueableMost* run_last = NULL;
+    size_t run_length = 0;
+    while (!fragment.Empty())
+    {
+      T* element = fragment.PopAny().release();
+      queue::tRecyclingChannel* origin = static_cast<queue::tRecyclableBase*>(element)->origin;
+      if (origin == run_channel)
+      {
+        run_last->next_queueable.store(element, std::memory_order_relaxed);
+        run_last = element;
+        run_length++;
+        continue;
+      }
+      if (run_first)
+      {
+        run_channel->Return(run_first, run_last, run_length);
+      }
+      run_channel = origin;
+      run_first = element;
+      run_last = element;
+      run_length = 1;
+    }
+    if (run_first)
+    {
+      run_channel->Return(run_first, run_last, run_length);
+    }
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Return channel of this pool */
+  queue::tRecyclingChannel* channel;
+
+  /*! Chain of unused elements taken from return channel */
+  queue::tQueueableMost* unused;
+
+  static void DeleteElement(queue::tQueueableMost* element)
+  {
+    delete static_cast<T*>(element);
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
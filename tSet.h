@@ -41,6 +41,10 @@
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
 #include "rrlib/logging/messages.h"
+#include <memory>
+#include <vector>
+#include <functional>
+#include <thread>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
@@ -68,6 +72,16 @@ enum class tAllowDuplicates
   YES_OPTIMIZED  //!< Same as above with more efficient adding of elements at a slightly increased memory footprint (typically additional size_t variable that stores first free slot)
 };
 
+/*!
+ * Result of tSet::IterateChangesSince()
+ */
+enum class tChangeIterationResult
+{
+  COMPLETE,      //!< Function was called for all changes since the specified version
+  LOG_OVERFLOW,  //!< Changes since the specified version are not all in the change log anymore: the set needs to be scanned
+  INCONSISTENT   //!< The change log could not be read consistently within the maximum number of attempts (as with TryReadConsistent()). Function was not called and version is unchanged.
+};
+
 /*!
  * Provides the default "null element" for sets
  */
@@ -77,6 +91,12 @@ struct NullElementDefault
   static constexpr T cNULL_ELEMENT = 0;
 };
 
+template <typename T, typename TDeleter>
+struct NullElementDefault<std::unique_ptr<T, TDeleter>>
+{
+  static constexpr T* cNULL_ELEMENT = nullptr;
+};
+
 
 //----------------------------------------------------------------------
 // Class declaration
@@ -89,9 +109,13 @@ struct NullElementDefault
  * (the only exception is single-threaded storage policy guarded with locks).
  * Typically based on array lists, iterating is quick and memory consumption low.
  * Modifying is typically quite expensive, though (O(n)).
+ * SkipList storage keeps elements ordered instead (with O(log n) modifications).
  *
  * \tparam T Type of list elements. T must be suitable for std::atomic<T> or a unique_ptr type.
  *           (Otherwise removing of elements concurrently to reading would cause issues)
+ *           With unique_ptr types, the set owns its elements: removed elements are deleted
+ *           as soon as no iterator can point to them anymore (supported by ArrayChunkBased storage).
+ *           Internally, raw pointers are stored (see tElement).
  * \tparam ALLOW_DUPLICATES Can set contain an element multiple times? (see enum constants above)
  * \tparam TMutex Type of mutex to use for non-concurrent list operations (typically concurrent modifying calls).
  *                May be set to tNoMutex if concurrent calls to these operations cannot occur.
@@ -120,19 +144,73 @@ class tSet : TStoragePolicy::template tInstance<T, ALLOW_DUPLICATES, TMutex, TNu
    */
   typedef typename tStoragePolicy::tConstIterator tConstIterator;
 
+  /*!
+   * Type of elements stored in set.
+   * Identical to T - except for sets of unique pointers, which store raw pointers to the owned elements.
+   */
+  typedef typename tStoragePolicy::tElement tElement;
+
+  /*!
+   * Handle to an element in the set - as returned by Add().
+   * Allows removing the element in constant time (see Remove()).
+   * Elements do not move to other slots (there is no compaction) - so handles remain valid as long as the element is in the set.
+   * With the array-chunk-based storage policies, handles also contain the slot's generation (which changes whenever an element is removed).
+   * With the other storage policies, handles refer to the element value.
+   * Default-constructed handles are invalid.
+   */
+  typedef typename tStoragePolicy::tHandle tHandle;
+
   /*!
    * Adds element to this set (unless element is already in the set and duplicates are not allowed)
    *
    * \param element Element to add
+   * \return Handle to element in set (with duplicates not allowed and element already in set: handle to this element)
    */
-  void Add(const T& element)
+  tHandle Add(const T& element)
 {
   if (element == static_cast<T>(TNullElement::cNULL_ELEMENT))
   {
     RRLIB_LOG_PRINT(ERROR, "The 'null element' may not be added to set. Ignoring. Please fix your code.");
-    return;
+    return tHandle();
   }
-  tStoragePolicy::Add(element);
+  return tStoragePolicy::Add(element);
+}
+
+/*!
+ * Adds element to this set of unique pointers.
+ * The set takes ownership of the element.
+ *
+ * \param element Element to add
+ * \return Handle to element in set
+ */
+template <bool OWNING = !std::is_same<T, tElement>::value>
+tHandle Add(typename std::enable_if<OWNING, T>::type && element)
+{
+  if (!element)
+  {
+    RRLIB_LOG_PRINT(ERROR, "The 'null element' may not be added to set. Ignoring. Please fix your code.");
+    return tHandle();
+  }
+  tHandle handle = tStoragePolicy::Add(element.get());
+  element.release();
+  return handle;
+}
+
+/*!
+ * Adds all elements in the specified range to this set.
+ * Compared to calling Add() for every element, this is significantly more efficient
+ * with storage policies that acquire a lock for modifications
+ * (typically the lock is acquired only once and the set is traversed only once).
+ * Null elements in range are ignored.
+ * Elements need to be comparable with the '<' operator (used for efficient duplicate detection).
+ *
+ * \param begin Iterator to first element to add
+ * \param end Iterator past the last element to add
+ */
+template <typename TIterator>
+void AddRange(TIterator begin, TIterator end)
+{
+  tStoragePolicy::AddRange(begin, end);
 }
 
 /*!
@@ -159,6 +237,33 @@ void Clear()
   return tStoragePolicy::Clear();
 }
 
+/*!
+ * \param element Element to look for
+ * \return True if set contains element
+ *         (O(1) with AtomicBitset storage - linear search with other storage policies)
+ */
+bool Contains(const tElement& element) const
+{
+  return tStoragePolicy::Contains(element);
+}
+
+/*!
+ * Copies all elements in set to a contiguous buffer.
+ * Chunks are copied in bulk - without the overhead of iterators - and free slots are skipped.
+ * If the set is modified concurrently, elements added or removed meanwhile might or might not be copied
+ * (as when iterating over the set; for an exact copy see TrySnapshot()).
+ * With sets of unique pointers, copied pointers may be deleted as soon as the element is removed from the set.
+ * (requires ArrayChunkBased storage)
+ *
+ * \param buffer Buffer to copy elements to
+ * \param capacity Capacity of buffer (number of elements)
+ * \return Number of elements in set. If this is larger than capacity, only the first 'capacity' elements were copied.
+ */
+size_t CopyTo(tElement* buffer, size_t capacity) const
+{
+  return tStoragePolicy::CopyTo(buffer, capacity);
+}
+
 /*!
  * \return True if set is empty
  */
@@ -175,6 +280,89 @@ tConstIterator End() const
   return tStoragePolicy::End();
 }
 
+/*!
+ * Calls function for all elements in set - with the set partitioned into pieces that are processed in parallel.
+ * Concurrency guarantees are the same as with iterating over the set (iterating is lock-free).
+ * The calling thread processes the last piece and returns after all pieces have been processed.
+ * (requires ArrayChunkBased storage)
+ *
+ * Typical executor that runs pieces in new threads:
+ *
+ *   [](std::function<void()> task) { return std::async(std::launch::async, task); }
+ *
+ * \param function Function or functor with signature 'void (const T&)' (or the dereferenced type with dereferencing iterators).
+ *                 Is called concurrently by multiple threads.
+ * \param executor Function or functor that executes a task (std::function<void()>) asynchronously.
+ *                 Needs to return an object with a wait() method that blocks until task has been executed (e.g. a std::future).
+ * \param pieces Maximum number of pieces to split set into
+ */
+template <typename TFunction, typename TExecutor>
+void ForEachParallel(TFunction function, TExecutor executor, size_t pieces = std::thread::hardware_concurrency())
+{
+  std::vector<tConstIterator> partition = Partition(pieces);
+  std::vector<decltype(executor(std::function<void()>()))> pending;
+  for (size_t i = 0; i + 1 < partition.size(); i++)
+  {
+    tConstIterator piece = partition[i];
+    pending.push_back(executor(std::function<void()>([this, piece, &function]()
+    {
+      for (tConstIterator it = piece; it != End(); ++it)
+      {
+        function(*it);
+      }
+    })));
+  }
+  for (tConstIterator it = partition.back(); it != End(); ++it)
+  {
+    function(*it);
+  }
+  for (auto it = pending.begin(); it != pending.end(); ++it)
+  {
+    it->wait();
+  }
+}
+
+/*!
+ * Returns an iterator to the first element that is not smaller than the specified one
+ * (e.g. to iterate over a range of elements).
+ * (requires SkipList storage)
+ *
+ * \param element Element to compare with
+ * \return Iterator pointing to the first element that is not smaller than 'element' (End() if there is none)
+ */
+tConstIterator LowerBound(const tElement& element) const
+{
+  return tStoragePolicy::LowerBound(element);
+}
+
+/*!
+ * Splits set into pieces of balanced size (e.g. for processing them in parallel - see ForEachParallel()).
+ * Each of the returned iterators iterates over one piece: it reaches End() when the piece has been processed.
+ * Elements added after calling this, might not be included in any piece.
+ * (requires ArrayChunkBased storage)
+ *
+ * \param pieces Maximum number of pieces (fewer pieces are returned for small sets)
+ * \return Iterators pointing to the first element of each piece (at least one)
+ */
+std::vector<tConstIterator> Partition(size_t pieces) const
+{
+  return tStoragePolicy::Partition(pieces);
+}
+
+/*!
+ * Allocates memory so that the set can hold the specified number of elements
+ * (or rather slots - as removed elements might leave free slots) without allocating further memory.
+ * Adding elements is then free of memory allocations (e.g. for real-time threads).
+ * In debug mode, there is an assertion if memory is allocated after calling this.
+ * (requires ArrayChunkBased storage)
+ *
+ * \param capacity Number of elements/slots to reserve memory for
+ */
+void Reserve(size_t capacity)
+{
+  tStoragePolicy::Reserve(capacity);
+}
+
 /*!
  * Removes element at specified position from set.
  *
@@ -186,13 +374,26 @@ tConstIterator Remove(tConstIterator position)
   return tStoragePolicy::Remove(position);
 }
 
+/*!
+ * Removes element with specified handle from set.
+ * With the array-chunk-based storage policies, this is an O(1) operation (amortized - if element is in the last used slot, the free slots at the back are removed)
+ * and nothing happens if the element has already been removed - even if an equal element was added to the same slot again.
+ * With the other storage policies, an equal element is removed (as with Remove(element)).
+ *
+ * \param handle Handle of element to remove (as returned by Add())
+ */
+void Remove(const tHandle& handle)
+{
+  tStoragePolicy::Remove(handle);
+}
+
 /*!
  * Removes specified element from set.
  * If the set contains this element multiple times, it is removed multiple times (== operator is used to check equality)
  *
  * \param element Element to remove from set
  */
-void Remove(const T& element)
+void Remove(const tElement& element)
 {
   if (element == TNullElement::cNULL_ELEMENT)
   {
@@ -202,6 +403,101 @@ void Remove(const T& element)
   tStoragePolicy::Remove(element);
 }
 
+/*!
+ * Removes all elements in the specified range from set (like calling Remove(element) for each of them - but more efficiently).
+ * Elements are compared using the '<' operator.
+ *
+ * \param begin Iterator to first element to remove
+ * \param end Iterator past the last element to remove
+ */
+template <typename TIterator>
+void RemoveAll(TIterator begin, TIterator end)
+{
+  tStoragePolicy::RemoveAll(begin, end);
+}
+
+/*!
+ * Removes all elements from set that satisfy the specified predicate.
+ *
+ * \param predicate Function or functor with signature 'bool (const tElement&)' that returns true for all elements to remove
+ */
+template <typename TPredicate>
+void RemoveIf(TPredicate predicate)
+{
+  tStoragePolicy::RemoveIf(predicate);
+}
+
+/*!
+ * Copies all elements in set to vector (see CopyTo())
+ * (requires ArrayChunkBased storage)
+ *
+ * \param snapshot Vector to copy elements to (any previous contents are discarded)
+ */
+void Snapshot(std::vector<tElement>& snapshot) const
+{
+  tStoragePolicy::Snapshot(snapshot);
+}
+
+/*!
+ * \return Version of set. Is incremented with every modification of the set.
+ * (requires ArrayChunkBased storage)
+ */
+size_t GetVersion() const
+{
+  return tStoragePolicy::GetVersion();
+}
+
+/*!
+ * Calls function for every change (element added or removed) since the specified version of the set - in the order of the changes.
+ * This way, components can track changes of the set without comparing the set's contents.
+ * Does not acquire any locks or allocate memory (changes are collected in an array with CHANGE_LOG_SIZE entries on the stack).
+ * (requires ArrayChunkBased storage with change log - see CHANGE_LOG_SIZE)
+ *
+ * \param version Version to iterate over changes since (e.g. obtained from GetVersion()).
+ *                Is set to the version of the set that includes the last visited change (to be used in the next call).
+ *                This is also done if LOG_OVERFLOW is returned.
+ * \param function Function or functor with signature 'void (const tElement& element, bool added)'
+ * \param max_attempts Maximum number of attempts to read the change log (with a set that is modified frequently, reading might never succeed)
+ * \return Whether changes were iterated over (see tChangeIterationResult)
+ */
+template <typename TFunction>
+tChangeIterationResult IterateChangesSince(size_t& version, TFunction function, size_t max_attempts) const
+{
+  return tStoragePolicy::IterateChangesSince(version, function, max_attempts);
+}
+
+/*!
+ * Reads set consistently - without acquiring any locks (seqlock-style).
+ * Function is called with begin and end iterators of the set.
+ * If the set is modified concurrently while function iterates over it,
+ * the attempt is discarded and function is called again.
+ * Therefore, function should not have side effects except for the (re-)initialization of its results.
+ * (requires ArrayChunkBased storage)
+ *
+ * \param function Function or functor with signature 'void (tConstIterator begin, tConstIterator end)'
+ * \param max_attempts Maximum number of attempts (with a set that is modified frequently, reading might never succeed)
+ * \return True if last call to function iterated over a consistent state of the set (no concurrent modifications)
+ */
+template <typename TFunction>
+bool TryReadConsistent(TFunction function, size_t max_attempts) const
+{
+  return tStoragePolicy::TryReadConsistent(function, max_attempts);
+}
+
+/*!
+ * Copies all elements in set to vector - so that the vector contains an exact snapshot of the set.
+ * Does not acquire any locks (see TryReadConsistent()).
+ * (requires ArrayChunkBased storage)
+ *
+ * \param snapshot Vector to copy elements to (any previous contents are discarded)
+ * \param max_attempts Maximum number of attempts
+ * \return True if snapshot is consistent. If false is returned, the vector's contents are unspecified.
+ */
+bool TrySnapshot(std::vector<tElement>& snapshot, size_t max_attempts) const
+{
+  return tStoragePolicy::TrySnapshot(snapshot, max_attempts);
+}
+
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
@@ -216,5 +512,8 @@ private:
 }
 
 #include "rrlib/concurrent_containers/policies/set/storage/ArrayChunkBased.h"
+#include "rrlib/concurrent_containers/policies/set/storage/AtomicBitset.h"
+#include "rrlib/concurrent_containers/policies/set/storage/LockFreeArrayChunkBased.h"
+#include "rrlib/concurrent_containers/policies/set/storage/SkipList.h"
 
 #endif
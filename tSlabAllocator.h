@@ -0,0 +1,380 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/tSlabAllocator.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tSlabAllocator
+ *
+ * \b tSlabAllocator
+ *
+ * Thread-caching slab allocator for objects of a single type - typically queueable elements.
+ * Provides a deleter type that can be used as deleter of unique pointers in tQueue.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__concurrent_containers__tSlabAllocator_h__
+#define __rrlib__concurrent_containers__tSlabAllocator_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tTaggedPointer.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Thread-caching slab allocator
+/*!
+ * Allocator for objects of type T - with per-thread caches (magazines as proposed by Bonwick).
+ * Intended for elements derived from tQueueable<...> that are enqueued in tQueue<std::unique_ptr<T, tSlabAllocator<T>::tDeleter>, ...>:
+ * Typically, such elements are allocated by a producer thread and deleted by a consumer thread.
+ *
+ * Each thread has two magazines (arrays of free blocks): allocating and deleting objects
+ * usually only pushes or pops a pointer to/from the current magazine - without any atomic operations.
+ * When both magazines of a thread are full or empty, a magazine is exchanged with the global depot
+ * (lock-free stacks of full and empty magazines). So blocks freed on a consumer thread flow back
+ * to the producer thread in batches of MAGAZINE_SIZE.
+ * If the depot contains no full magazine, a new slab with SLAB_SIZE blocks is allocated.
+ *
+ * Memory is type-stable: slabs are never returned to the system - and blocks are only reused for objects of type T.
+ * All state is static, so the deleter is an empty class and unique pointers have the size of a raw pointer
+ * (as required by tQueue). Elements of queue fragments (tQueueFragment) that are deleted in bulk
+ * are also returned to the calling thread's magazines.
+ *
+ * \tparam T Type of objects to allocate
+ * \tparam SLAB_SIZE Number of blocks allocated at once
+ * \tparam MAGAZINE_SIZE Number of blocks in a magazine
+ * \tparam TAllocator Allocator for slabs (rebound to char - e.g. tHugePageArenaAllocator for pre-faulted, locked memory)
+ */
+template <typename T, size_t SLAB_SIZE = 256, size_t MAGAZINE_SIZE = 64, typename TAllocator = std::allocator<char>>
+class tSlabAllocator
+{
+  static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types are not supported");
+  static_assert(SLAB_SIZE > 0 && MAGAZINE_SIZE > 0, "Slabs and magazines must not be empty");
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Deleter for unique pointers to objects allocated with this allocator */
+  struct tDeleter
+  {
+    void operator()(T* object) const
+    {
+      object->~T();
+      Deallocate(object);
+    }
+  };
+
+  /*! Unique pointer to object allocated with this allocator */
+  typedef std::unique_ptr<T, tDeleter> tPointer;
+
+  static_assert(sizeof(tPointer) == sizeof(void*), "Deleter must not increase size of unique pointer");
+
+  /*!
+   * Allocates memory for an object of type T
+   * (prefer Create())
+   *
+   * \return Pointer to memory block
+   */
+  static void* Allocate()
+  {
+    tThreadCache& cache = ThreadCache();
+    if (cache.loaded->count == 0)
+    {
+      cache.Refill();
+    }
+    return cache.loaded->blocks[--cache.loaded->count];
+  }
+
+  /*!
+   * Creates object
+   *
+   * \param args Arguments for T's constructor
+   * \return Unique pointer to created object
+   */
+  template <typename ... TArgs>
+  static tPointer Create(TArgs && ... args)
+  {
+    void* memory = Allocate();
+    try
+    {
+      return tPointer(new(memory) T(std::forward<TArgs>(args)...));
+    }
+    catch (...)
+    {
+      Deallocate(memory);
+      throw;
+    }
+  }
+
+  /*!
+   * Returns memory block to allocator (object must have been destructed already)
+   *
+   * \param memory Memory block obtained via Allocate()
+   */
+  static void Deallocate(void* memory)
+  {
+    tThreadCache& cache = ThreadCache();
+    if (cache.loaded->count == MAGAZINE_SIZE)
+    {
+      cache.MakeRoom();
+    }
+    cache.loaded->blocks[cache.loaded->count++] = memory;
+  }
+
+  /*!
+   * \return Number of slabs allocated so far (multiply with SLAB_SIZE for capacity)
+   */
+  static size_t GetSlabCount()
+  {
+    return Depot().slab_count.load();
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Size of each block (multiple of max_align_t's alignment) */
+  enum { cBLOCK_SIZE = ((sizeof(T) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t)) * alignof(std::max_align_t) };
+
+  /*! Slabs are allocated as char arrays */
+  typedef typename std::allocator_traits<TAllocator>::template rebind_alloc<char> tSlabMemoryAllocator;
+
+  /*! Magazine: array of free blocks (magazine objects themselves are never deleted) */
+  struct __attribute__((aligned(8))) tMagazine
+  {
+    tMagazine() : count(0), next(NULL), next_allocated(NULL) {}
+
+    /*! Free blocks */
+    void* blocks[MAGAZINE_SIZE];
+
+    /*! Number of free blocks in magazine */
+    size_t count;
+
+    /*! Next magazine in depot stack */
+    std::atomic<tMagazine*> next;
+
+    /*! Next magazine in list of all magazines */
+    tMagazine* next_allocated;
+  };
+
+  typedef rrlib::util::tTaggedPointer<tMagazine, true, 16> tTaggedPointer;
+
+  /*! Lock-free stack of magazines (stamp avoids ABA problem) */
+  class tMagazineStack
+  {
+  public:
+
+    tMagazineStack() : head(tTaggedPointer(NULL, 0)) {}
+
+    tMagazine* Pop()
+    {
+      tTaggedPointer current = head.load();
+      while (current.GetPointer())
+      {
+        tMagazine* next = current.GetPointer()->next.load(std::memory_order_relaxed);  // magazines are never deleted
+        if (head.compare_exchange_weak(current, tTaggedPointer(next, current.GetStamp() + 1)))
+        {
+          return current.GetPointer();
+        }
+      }
+      return NULL;
+    }
+
+    void Push(tMagazine* magazine)
+    {
+      tTaggedPointer current = head.load();
+      do
+      {
+        magazine->next.store(current.GetPointer(), std::memory_order_relaxed);
+      }
+      while (!head.compare_exchange_weak(current, tTaggedPointer(magazine, current.GetStamp() + 1)));
+    }
+
+  private:
+
+    std::atomic<typename tTaggedPointer::tStorage> head;
+  };
+
+  /*! Global depot (shared by all threads) */
+  struct tDepot
+  {
+    tDepot() : all_magazines(NULL), slab_count(0) {}
+
+    /*! Full (or partially filled) magazines */
+    tMagazineStack full_magazines;
+
+    /*! Empty magazines */
+    tMagazineStack empty_magazines;
+
+    /*! List of all magazines ever allocated (keeps them - and therefore slabs - reachable for leak checkers) */
+    std::atomic<tMagazine*> all_magazines;
+
+    /*! Number of slabs allocated */
+    std::atomic<size_t> slab_count;
+  };
+
+  /*! Magazines of a thread */
+  struct tThreadCache
+  {
+    tThreadCache() : loaded(GetEmptyMagazine()), previous(GetEmptyMagazine()) {}
+
+    /*! Returns magazines to depot when thread exits */
+    ~tThreadCache()
+    {
+      ReturnToDepot(loaded);
+      ReturnToDepot(previous);
+    }
+
+    /*! Ensures that loaded magazine is not empty */
+    void Refill()
+    {
+      if (previous->count > 0)
+      {
+        std::swap(loaded, previous);
+        return;
+      }
+      tMagazine* full = Depot().full_magazines.Pop();
+      if (full)
+      {
+        Depot().empty_magazines.Push(previous);
+        previous = loaded;
+        loaded = full;
+        return;
+      }
+      AllocateSlab();
+    }
+
+    /*! Ensures that loaded magazine is not full */
+    void MakeRoom()
+    {
+      if (previous->count < MAGAZINE_SIZE)
+      {
+        std::swap(loaded, previous);
+        return;
+      }
+      Depot().full_magazines.Push(previous);
+      previous = loaded;
+      loaded = GetEmptyMagazine();
+    }
+
+    /*! Allocates new slab and fills (empty) loaded magazine - further blocks are pushed to depot */
+    void AllocateSlab()
+    {
+      tSlabMemoryAllocator allocator;
+      char* slab = std::allocator_traits<tSlabMemoryAllocator>::allocate(allocator, SLAB_SIZE * cBLOCK_SIZE);
+      Depot().slab_count++;
+      size_t i = 0;
+      for (; i < SLAB_SIZE && loaded->count < MAGAZINE_SIZE; i++)
+      {
+        loaded->blocks[loaded->count++] = slab + i * cBLOCK_SIZE;
+      }
+      while (i < SLAB_SIZE)
+      {
+        tMagazine* magazine = GetEmptyMagazine();
+        for (; i < SLAB_SIZE && magazine->count < MAGAZINE_SIZE; i++)
+        {
+          magazine->blocks[magazine->count++] = slab + i * cBLOCK_SIZE;
+        }
+        Depot().full_magazines.Push(magazine);
+      }
+    }
+
+    static void ReturnToDepot(tMagazine* magazine)
+    {
+      if (magazine->count)
+      {
+        Depot().full_magazines.Push(magazine);
+      }
+      else
+      {
+        Depot().empty_magazines.Push(magazine);
+      }
+    }
+
+    /*! Current magazine */
+    tMagazine* loaded;
+
+    /*! Previous magazine (either full or empty unless thread just started) */
+    tMagazine* previous;
+  };
+
+  static tDepot& Depot()
+  {
+    static tDepot depot;
+    return depot;
+  }
+
+  static tMagazine* GetEmptyMagazine()
+  {
+    tMagazine* magazine = Depot().empty_magazines.Pop();
+    if (!magazine)
+    {
+      magazine = new tMagazine();
+      magazine->next_allocated = Depot().all_magazines.load();
+      while (!Depot().all_magazines.compare_exchange_weak(magazine->next_allocated, magazine)) {}
+    }
+    return magazine;
+  }
+
+  static tThreadCache& ThreadCache()
+  {
+    static thread_local tThreadCache cache;
+    return cache;
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
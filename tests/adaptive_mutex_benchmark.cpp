@@ -0,0 +1,146 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/tests/adaptive_mutex_benchmark.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * Compares tSet modification performance with tAdaptiveMutex and rrlib::thread::tMutex -
+ * with different numbers of threads contending for the set.
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages.h"
+#include "rrlib/util/tUnitTestSuite.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tSet.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+const int cOPERATIONS_PER_THREAD = 200000;
+const int cSTABLE_ELEMENTS = 16;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+/*!
+ * Runs benchmark: each thread repeatedly adds and removes its own element
+ *
+ * \return Average duration of Add or Remove call in nanoseconds
+ */
+template <typename TMutex>
+double RunBenchmark(int thread_count)
+{
+  tSet<int, tAllowDuplicates::NO, TMutex, set::storage::ArrayChunkBased<8, 8>> set;
+  for (int i = 1; i <= cSTABLE_ELEMENTS; i++)
+  {
+    set.Add(i);
+  }
+
+  std::vector<std::thread> threads;
+  auto start = std::chrono::steady_clock::now();
+  for (int t = 0; t < thread_count; t++)
+  {
+    threads.emplace_back([&set, t]()
+    {
+      int element = cSTABLE_ELEMENTS + 1 + t;
+      for (int i = 0; i < cOPERATIONS_PER_THREAD; i++)
+      {
+        set.Add(element);
+        set.Remove(element);
+      }
+    });
+  }
+  for (auto it = threads.begin(); it != threads.end(); ++it)
+  {
+    it->join();
+  }
+  auto duration = std::chrono::steady_clock::now() - start;
+
+  int remaining = 0;
+  for (auto it = set.Begin(); it != set.End(); ++it)
+  {
+    remaining++;
+  }
+  RRLIB_UNIT_TESTS_EQUALITY(remaining, cSTABLE_ELEMENTS);
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()) / (2.0 * cOPERATIONS_PER_THREAD * thread_count);
+}
+
+class AdaptiveMutexBenchmark : public util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(AdaptiveMutexBenchmark);
+  RRLIB_UNIT_TESTS_ADD_TEST(Benchmark);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+  void Benchmark()
+  {
+    int max_threads = std::max(2u, std::thread::hardware_concurrency());
+    for (int threads = 1; threads <= max_threads; threads *= 2)
+    {
+      double adaptive_mutex = RunBenchmark<tAdaptiveMutex>(threads);
+      double rrlib_mutex = RunBenchmark<rrlib::thread::tMutex>(threads);
+      RRLIB_LOG_PRINT(USER, threads, " thread(s): tAdaptiveMutex ", adaptive_mutex, " ns/operation - rrlib::thread::tMutex ", rrlib_mutex, " ns/operation");
+    }
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(AdaptiveMutexBenchmark);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,275 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/tests/basic_map_test.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * Tests basic functionality of maps - including lookups concurrent to modifications and table growth.
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages.h"
+#include "rrlib/util/tUnitTestSuite.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tMap.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+/*!
+ * Test basic operations (map must be empty)
+ */
+template <typename TMap>
+void TestMap(TMap& map)
+{
+  RRLIB_UNIT_TESTS_ASSERT(map.Empty());
+  for (int i = 1; i <= 100; i++)
+  {
+    RRLIB_UNIT_TESTS_ASSERT(map.Insert("port" + std::to_string(i), i));
+  }
+  RRLIB_UNIT_TESTS_ASSERT(!map.Insert("port1", 1000));
+  RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Null element must not be inserted", !map.Insert("port0", 0));
+  RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Null element must not be set", map.Set("port1", 0), 0);
+  RRLIB_UNIT_TESTS_EQUALITY(map.Get("port1"), 1);
+  RRLIB_UNIT_TESTS_EQUALITY(map.Size(), static_cast<size_t>(100));
+  for (int i = 1; i <= 100; i++)
+  {
+    RRLIB_UNIT_TESTS_EQUALITY(map.Get("port" + std::to_string(i)), i);
+  }
+  RRLIB_UNIT_TESTS_EQUALITY(map.Get("port101"), 0);
+  RRLIB_UNIT_TESTS_ASSERT(!map.Contains("port0") && map.Contains("port100"));
+
+  RRLIB_UNIT_TESTS_EQUALITY(map.Set("port5", 500), 5);
+  RRLIB_UNIT_TESTS_EQUALITY(map.Set("port200", 200), 0);
+  RRLIB_UNIT_TESTS_EQUALITY(map.Get("port5"), 500);
+  RRLIB_UNIT_TESTS_EQUALITY(map.Remove("port200"), 200);
+  RRLIB_UNIT_TESTS_EQUALITY(map.Remove("port200"), 0);
+  for (int i = 2; i <= 100; i += 2)
+  {
+    map.Remove("port" + std::to_string(i));
+  }
+  RRLIB_UNIT_TESTS_EQUALITY(map.Size(), static_cast<size_t>(50));
+
+  int count = 0;
+  int sum = 0;
+  map.ForEach([&](const std::string & key, int value)
+  {
+    RRLIB_UNIT_TESTS_ASSERT(key == "port" + std::to_string(value == 500 ? 5 : value));
+    count++;
+    sum += value;
+  });
+  RRLIB_UNIT_TESTS_EQUALITY(count, 50);
+  RRLIB_UNIT_TESTS_EQUALITY(sum, 2500 - 5 + 500);
+
+  map.Clear();
+  RRLIB_UNIT_TESTS_ASSERT(map.Empty() && !map.Contains("port1"));
+}
+
+/*!
+ * Test lookups concurrent to modifications (map must be empty)
+ */
+template <typename TMap>
+void TestConcurrentLookups(TMap& map)
+{
+  const int cSTABLE_KEYS = 100;
+  const int cKEYS = 2000;
+  for (int i = 1; i <= cSTABLE_KEYS; i++)
+  {
+    map.Insert(i, i);
+  }
+
+  std::atomic<bool> stop(false);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 3; t++)
+  {
+    readers.emplace_back([&map, &stop]()
+    {
+      while (!stop.load())
+      {
+        for (int i = 1; i <= cSTABLE_KEYS; i++)
+        {
+          RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Stable entries must always be found", map.Get(i), i);
+        }
+        int count = 0;
+        map.ForEach([&count](int key, int value)
+        {
+          if (key <= cSTABLE_KEYS)
+          {
+            RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Stable entries must have their original value", value, key);
+            count++;
+          }
+          else
+          {
+            RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Visited entries must have a value that was set for their key", value == key || value == -key);
+          }
+        });
+        RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Stable entries must be visited exactly once", count, cSTABLE_KEYS);
+      }
+    });
+  }
+
+  std::vector<std::thread> writers;
+  for (int t = 0; t < 2; t++)
+  {
+    writers.emplace_back([&map, t]()
+    {
+      for (int i = cSTABLE_KEYS + 1 + t; i <= cKEYS; i += 2)
+      {
+        map.Insert(i, i);
+        map.Set(i, -i);
+      }
+      for (int i = cSTABLE_KEYS + 1 + t; i <= cKEYS; i += 4)
+      {
+        map.Remove(i);
+      }
+    });
+  }
+  for (auto it = writers.begin(); it != writers.end(); ++it)
+  {
+    it->join();
+  }
+  stop = true;
+  for (auto it = readers.begin(); it != readers.end(); ++it)
+  {
+    it->join();
+  }
+
+  for (int i = cSTABLE_KEYS + 1; i <= cKEYS; i++)
+  {
+    bool removed = ((i - cSTABLE_KEYS - 1) % 4) < 2;
+    RRLIB_UNIT_TESTS_EQUALITY(map.Get(i), removed ? 0 : -i);
+  }
+}
+
+/*!
+ * Test modifications of the same keys by concurrent writers (map must be empty)
+ */
+template <typename TMap>
+void TestConcurrentWriters(TMap& map)
+{
+  const int cKEYS = 3000;
+  const int cWRITERS = 4;
+  std::atomic<int> inserted(0);
+  std::vector<std::thread> writers;
+  for (int t = 0; t < cWRITERS; t++)
+  {
+    writers.emplace_back([&map, &inserted, t]()
+    {
+      for (int i = 1; i <= cKEYS; i++)
+      {
+        int key = ((i * 7) + t * 13) % cKEYS + 1;
+        inserted += map.Insert(key, key) ? 1 : 0;
+        map.Set(key, -key);
+      }
+    });
+  }
+  for (auto it = writers.begin(); it != writers.end(); ++it)
+  {
+    it->join();
+  }
+  RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Every key must be inserted exactly once", inserted.load(), cKEYS);
+  RRLIB_UNIT_TESTS_EQUALITY(map.Size(), static_cast<size_t>(cKEYS));
+  for (int i = 1; i <= cKEYS; i++)
+  {
+    RRLIB_UNIT_TESTS_EQUALITY(map.Get(i), -i);
+  }
+}
+
+class BasicMapTest : public util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(BasicMapTest);
+  RRLIB_UNIT_TESTS_ADD_TEST(Test);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+  void Test()
+  {
+    {
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Testing tMap<std::string, int, rrlib::thread::tMutex, map::storage::HashTable<>>");
+      tMap<std::string, int, rrlib::thread::tMutex, map::storage::HashTable<>> map;
+      TestMap(map);
+      TestMap(map);
+    }
+
+    {
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Testing tMap<std::string, int, rrlib::thread::tNoMutex, map::storage::HashTable<2, 300>>");
+      tMap<std::string, int, rrlib::thread::tNoMutex, map::storage::HashTable<2, 300>> map;
+      TestMap(map);
+    }
+
+    {
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Testing concurrent lookups with tMap<int, int, tAdaptiveMutex, map::storage::HashTable<4>>");
+      tMap<int, int, tAdaptiveMutex, map::storage::HashTable<4>> map;
+      TestConcurrentLookups(map);
+    }
+    {
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Testing concurrent writers with tMap<int, int, tAdaptiveMutex, map::storage::HashTable<8>>");
+      tMap<int, int, tAdaptiveMutex, map::storage::HashTable<8>> map;
+      TestConcurrentWriters(map);
+    }
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(BasicMapTest);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
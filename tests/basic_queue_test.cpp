@@ -79,6 +79,11 @@ struct tTestType : public tFirstBaseClass, public tQueueable<QA>
   }
 };
 
+// bounded fragment queues with tQueueability::MOST are blocking - and need to be enabled explicitly
+template <>
+struct tAllowBlockingBoundedFragmentQueue<tTestType<tQueueability::MOST>> : std::true_type
+{};
+
 template <bool BOUNDED>
 struct tMaxQueueLength
 {
@@ -331,6 +336,9 @@ class BasicQueueTest : public util::tUnitTestSuite
     TestFragmentQueueConcurrencyLevels<1, tQueueability::FULL>();
     TestFragmentQueueConcurrencyLevels<2, tQueueability::FULL>();
     TestFragmentQueueConcurrencyLevels<5, tQueueability::FULL>();
+    TestFragmentQueueConcurrencyLevels<1, tQueueability::MOST>();
+    TestFragmentQueueConcurrencyLevels<2, tQueueability::MOST>();
+    TestFragmentQueueConcurrencyLevels<5, tQueueability::MOST>();
   }
 
 };
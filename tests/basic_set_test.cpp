@@ -34,11 +34,16 @@
 //----------------------------------------------------------------------
 #include "rrlib/logging/messages.h"
 #include "rrlib/util/tUnitTestSuite.h"
+#include <thread>
+#include <future>
+#include <vector>
+#include <algorithm>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
 #include "rrlib/concurrent_containers/tSet.h"
+#include "rrlib/concurrent_containers/tHugePageArena.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -126,6 +131,532 @@ void TestSet(TSet& set, bool duplicates_allowed)
   }
 }
 
+/*!
+ * Test batch operations on int-sets
+ */
+template <typename TSet>
+void TestBatchOperations(TSet& set, bool duplicates_allowed)
+{
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, " Adding elements 1 to 20 (and some again) with AddRange");
+  std::vector<int> batch;
+  for (int i = 1; i <= 20; ++i)
+  {
+    batch.push_back(i);
+  }
+  set.AddRange(batch.begin(), batch.begin() + 10);
+  set.AddRange(batch.begin() + 5, batch.end());
+  int i = 0;
+  for (auto it = set.Begin(); it != set.End(); ++it)
+  {
+    i++;
+    RRLIB_UNIT_TESTS_ASSERT(duplicates_allowed || (*it == i));
+  }
+  RRLIB_UNIT_TESTS_EQUALITY(i, duplicates_allowed ? 25 : 20);
+
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, " Removing elements 5 to 15 with RemoveAll and odd elements with RemoveIf");
+  set.RemoveAll(batch.begin() + 4, batch.begin() + 15);
+  set.RemoveIf([](int element)
+  {
+    return (element % 2) == 1;
+  });
+  i = 0;
+  for (auto it = set.Begin(); it != set.End(); ++it)
+  {
+    RRLIB_UNIT_TESTS_ASSERT((*it % 2) == 0 && (*it < 5 || *it > 15));
+    i++;
+  }
+  RRLIB_UNIT_TESTS_EQUALITY(i, 5);
+
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, " Filling free slots with AddRange");
+  set.AddRange(batch.begin(), batch.end());
+  i = 0;
+  for (auto it = set.Begin(); it != set.End(); ++it)
+  {
+    i++;
+  }
+  RRLIB_UNIT_TESTS_EQUALITY(i, duplicates_allowed ? 25 : 20);
+  set.Clear();
+  RRLIB_UNIT_TESTS_ASSERT(set.Begin() == set.End());
+}
+
+/*!
+ * Test removing elements via handles returned by Add() (set must be empty)
+ */
+template <typename TSet>
+void TestHandles(TSet& set)
+{
+  std::vector<typename TSet::tHandle> handles;
+  for (int i = 1; i <= 20; i++)
+  {
+    handles.push_back(set.Add(i));
+  }
+  for (int i = 1; i <= 20; i += 2)
+  {
+    set.Remove(handles[i - 1]);
+  }
+  set.Remove(handles[0]);  // removed already
+  set.Remove(typename TSet::tHandle());
+  typename TSet::tHandle readded = set.Add(1);  // reuses slot of removed element
+  set.Remove(handles[0]);
+  RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Stale handle must not remove element that was added again", set.Contains(1));
+  set.Remove(readded);
+  RRLIB_UNIT_TESTS_ASSERT(!set.Contains(1));
+  int count = 0;
+  for (auto it = set.Begin(); it != set.End(); ++it)
+  {
+    RRLIB_UNIT_TESTS_ASSERT((*it % 2) == 0);
+    count++;
+  }
+  RRLIB_UNIT_TESTS_EQUALITY(count, 10);
+
+  typename TSet::tHandle handle = set.Add(21);
+  RRLIB_UNIT_TESTS_ASSERT(*set.Begin() == 21);  // free slots are reused
+  set.Remove(handle);
+  for (int i = 2; i <= 20; i += 2)
+  {
+    set.Remove(handles[i - 1]);
+  }
+  RRLIB_UNIT_TESTS_ASSERT(set.Empty());
+  RRLIB_UNIT_TESTS_ASSERT(set.Begin() == set.End());
+}
+
+/*!
+ * Test copying set to contiguous buffers (set must be empty)
+ */
+template <typename TSet>
+void TestCopyTo(TSet& set)
+{
+  for (int i = 1; i <= 30; i++)
+  {
+    set.Add(i);
+  }
+  set.RemoveIf([](int element)
+  {
+    return (element % 3) == 0;
+  });
+
+  std::vector<int> snapshot;
+  set.Snapshot(snapshot);
+  RRLIB_UNIT_TESTS_EQUALITY(snapshot.size(), static_cast<size_t>(20));
+  std::vector<int> expected(set.Begin(), set.End());
+  RRLIB_UNIT_TESTS_ASSERT(snapshot == expected);
+
+  int buffer[25];
+  RRLIB_UNIT_TESTS_EQUALITY(set.CopyTo(buffer, 25), static_cast<size_t>(20));
+  RRLIB_UNIT_TESTS_ASSERT(std::equal(expected.begin(), expected.end(), buffer));
+  buffer[7] = -1;
+  RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Element count must be reported for insufficient buffers", set.CopyTo(buffer, 7), static_cast<size_t>(20));
+  RRLIB_UNIT_TESTS_ASSERT(std::equal(expected.begin(), expected.begin() + 7, buffer));
+  RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Buffer must not be written beyond capacity", buffer[7], -1);
+}
+
+/*!
+ * Test change tracking (set must be empty and have a change log with 8 entries)
+ */
+template <typename TSet>
+void TestChangeTracking(TSet& set)
+{
+  std::vector<std::pair<int, bool>> changes;
+  auto collect = [&changes](int element, bool added)
+  {
+    changes.push_back(std::pair<int, bool>(element, added));
+  };
+
+  size_t version = set.GetVersion();
+  set.Add(1);
+  set.Add(2);
+  set.Add(3);
+  set.Remove(2);
+  set.Remove(4);  // not in set: no change
+  RRLIB_UNIT_TESTS_ASSERT(set.IterateChangesSince(version, collect, 10) == tChangeIterationResult::COMPLETE);
+  std::vector<std::pair<int, bool>> expected = { {1, true}, {2, true}, {3, true}, {2, false} };
+  RRLIB_UNIT_TESTS_ASSERT(changes == expected);
+  RRLIB_UNIT_TESTS_EQUALITY(version, set.GetVersion());
+
+  changes.clear();
+  RRLIB_UNIT_TESTS_ASSERT(set.IterateChangesSince(version, collect, 10) == tChangeIterationResult::COMPLETE);
+  RRLIB_UNIT_TESTS_ASSERT(changes.empty());
+
+  set.Clear();
+  size_t version_before = version;
+  RRLIB_UNIT_TESTS_ASSERT(set.IterateChangesSince(version, collect, 0) == tChangeIterationResult::INCONSISTENT);
+  RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Nothing must be visited if attempts are exhausted", changes.empty() && version == version_before);
+  RRLIB_UNIT_TESTS_ASSERT(set.IterateChangesSince(version, collect, 10) == tChangeIterationResult::COMPLETE);
+  expected = { {1, false}, {3, false} };
+  RRLIB_UNIT_TESTS_ASSERT(changes == expected);
+
+  for (int i = 1; i <= 10; i++)
+  {
+    set.Add(i);
+  }
+  RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Change log must report that it overflowed", set.IterateChangesSince(version, collect, 10) == tChangeIterationResult::LOG_OVERFLOW);
+  RRLIB_UNIT_TESTS_EQUALITY(version, set.GetVersion());
+}
+
+/*!
+ * Test membership queries (set must be empty)
+ */
+template <typename TSet>
+void TestContains(TSet& set)
+{
+  for (int i = 1; i <= 100; i += 3)
+  {
+    set.Add(i);
+  }
+  for (int i = 1; i <= 100; i++)
+  {
+    RRLIB_UNIT_TESTS_EQUALITY(set.Contains(i), (i % 3) == 1);
+  }
+  set.Remove(4);
+  RRLIB_UNIT_TESTS_ASSERT(!set.Contains(4) && set.Contains(7));
+  RRLIB_UNIT_TESTS_ASSERT(!set.Contains(100000));
+  set.Clear();
+  RRLIB_UNIT_TESTS_ASSERT(!set.Contains(1) && set.Empty());
+}
+
+/*!
+ * Test concurrent adding of (partly identical) elements to set without duplicates
+ */
+template <typename TSet>
+void TestConcurrentAdd(TSet& set)
+{
+  const int cTHREADS = 4;
+  const int cELEMENTS = 500;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < cTHREADS; t++)
+  {
+    threads.emplace_back([&set, t]()
+    {
+      for (int i = 1; i <= cELEMENTS; i++)
+      {
+        set.Add(((i + t * 37) % cELEMENTS) + 1);
+      }
+    });
+  }
+  for (auto it = threads.begin(); it != threads.end(); ++it)
+  {
+    it->join();
+  }
+
+  std::vector<int> occurrences(cELEMENTS + 1, 0);
+  for (auto it = set.Begin(); it != set.End(); ++it)
+  {
+    occurrences[*it]++;
+  }
+  for (int i = 1; i <= cELEMENTS; i++)
+  {
+    RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Element " + std::to_string(i) + " must be in set exactly once", occurrences[i], 1);
+  }
+}
+
+/*!
+ * Test partitioned and parallel iteration (set must not allow duplicates)
+ */
+template <typename TSet>
+void TestParallelIteration(TSet& set)
+{
+  const int cELEMENTS = 1000;
+  RRLIB_UNIT_TESTS_ASSERT(set.Partition(4).size() == 1 && set.Partition(4)[0] == set.End());
+  for (int i = 1; i <= cELEMENTS; i++)
+  {
+    set.Add(i);
+  }
+  for (int i = 1; i <= cELEMENTS; i += 3)
+  {
+    set.Remove(i);
+  }
+
+  std::vector<std::atomic<int>> occurrences(cELEMENTS + 1);
+  for (auto it = occurrences.begin(); it != occurrences.end(); ++it)
+  {
+    it->store(0);
+  }
+  std::atomic<int> visited(0);
+  set.ForEachParallel([&](int element)
+  {
+    occurrences[element]++;
+    visited++;
+  }, [](std::function<void()> task)
+  {
+    return std::async(std::launch::async, task);
+  }, 7);
+  RRLIB_UNIT_TESTS_EQUALITY(visited.load(), cELEMENTS - ((cELEMENTS + 2) / 3));
+  for (int i = 1; i <= cELEMENTS; i++)
+  {
+    RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Element " + std::to_string(i) + " must be visited once (unless removed)", occurrences[i].load(), (i % 3) == 1 ? 0 : 1);
+  }
+  RRLIB_UNIT_TESTS_EQUALITY(set.Partition(7).size(), static_cast<size_t>(7));
+  RRLIB_UNIT_TESTS_ASSERT(set.Partition(100000).size() <= static_cast<size_t>(cELEMENTS));
+}
+
+/*!
+ * Test consistent reads while set is modified concurrently
+ */
+template <typename TSet>
+void TestConsistentReads(TSet& set)
+{
+  const int cSTABLE_ELEMENTS = 100;
+  for (int i = 1; i <= cSTABLE_ELEMENTS; i++)
+  {
+    set.Add(i);
+  }
+  std::vector<int> snapshot;
+  RRLIB_UNIT_TESTS_ASSERT(set.TrySnapshot(snapshot, 1));
+  RRLIB_UNIT_TESTS_EQUALITY(snapshot.size(), static_cast<size_t>(cSTABLE_ELEMENTS));
+
+  // Writer toggles one additional element - consistent snapshots contain it at most once
+  std::atomic<bool> stop(false);
+  std::thread writer([&]()
+  {
+    for (int i = 0; !stop; i++)
+    {
+      set.Add(cSTABLE_ELEMENTS + 1 + (i % 10));
+      set.Remove(cSTABLE_ELEMENTS + 1 + (i % 10));
+    }
+  });
+  int consistent_reads = 0;
+  for (int i = 0; i < 200; i++)
+  {
+    if (set.TrySnapshot(snapshot, 1000))
+    {
+      consistent_reads++;
+      std::sort(snapshot.begin(), snapshot.end());
+      RRLIB_UNIT_TESTS_ASSERT(snapshot.size() == cSTABLE_ELEMENTS || snapshot.size() == cSTABLE_ELEMENTS + 1);
+      for (int j = 0; j < cSTABLE_ELEMENTS; j++)
+      {
+        RRLIB_UNIT_TESTS_EQUALITY(snapshot[j], j + 1);
+      }
+    }
+  }
+  stop = true;
+  writer.join();
+  RRLIB_UNIT_TESTS_ASSERT(consistent_reads > 0);
+}
+
+/*! Number of allocations by tCountingAllocator */
+int counted_allocations = 0;
+
+/*! Allocator that counts allocations */
+template <typename T>
+struct tCountingAllocator : std::allocator<T>
+{
+  template <typename U>
+  struct rebind
+  {
+    typedef tCountingAllocator<U> other;
+  };
+
+  tCountingAllocator() {}
+  template <typename U>
+  tCountingAllocator(const tCountingAllocator<U>&) {}
+
+  T* allocate(size_t n)
+  {
+    counted_allocations++;
+    return std::allocator<T>::allocate(n);
+  }
+};
+
+/*!
+ * Test that adding elements does not allocate memory after calling Reserve()
+ */
+void TestReserve()
+{
+  typedef tSet<int, tAllowDuplicates::YES, rrlib::thread::tMutex, set::storage::ArrayChunkBased<2, 6, false, tCountingAllocator<char>>> tReservedSet;
+  tReservedSet set;
+  set.Reserve(40);
+  int allocations = counted_allocations;
+  RRLIB_UNIT_TESTS_ASSERT(allocations > 0);
+  for (int i = 1; i <= 40; i++)
+  {
+    set.Add(i);
+  }
+  set.Clear();
+  set.Reserve(20);
+  for (int i = 1; i <= 40; i++)
+  {
+    set.Add(i);
+  }
+  int count = 0;
+  for (auto it = set.Begin(); it != set.End(); ++it)
+  {
+    count++;
+  }
+  RRLIB_UNIT_TESTS_EQUALITY(count, 40);
+  RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("No memory must be allocated after Reserve()", counted_allocations, allocations);
+
+  // Initial chunk
+  typedef tSet<int, tAllowDuplicates::NO, rrlib::thread::tMutex, set::storage::ArrayChunkBased<2, 6, false, tCountingAllocator<char>>> tSmallSet;
+  {
+    tSmallSet small_set;
+    allocations = counted_allocations;
+    typename tSmallSet::tHandle handle = small_set.Add(1);
+    small_set.Add(2);
+    small_set.Remove(handle);
+    small_set.Add(3);
+    RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Adding elements to initial chunk must not allocate memory", counted_allocations, allocations);
+  }
+
+  // Reserved capacity is rounded up to chunk capacity
+  {
+    tSmallSet small_set;
+    small_set.Reserve(3);
+    allocations = counted_allocations;
+    for (int i = 1; i <= 8; i++)
+    {
+      small_set.Add(i);
+    }
+    small_set.Remove(8);
+    small_set.Add(9);
+    RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Adding elements up to reserved chunk capacity must not allocate memory", counted_allocations, allocations);
+  }
+}
+
+/*! Element that counts its deletions */
+struct tCountedElement
+{
+  static int deletions;
+
+  int value;
+
+  tCountedElement(int value) : value(value) {}
+  ~tCountedElement()
+  {
+    deletions++;
+  }
+};
+
+int tCountedElement::deletions = 0;
+
+/*!
+ * Test owning set of unique pointers: removed elements may only be deleted when no iterator can point to them anymore
+ */
+void TestOwningSet()
+{
+  tCountedElement::deletions = 0;
+  {
+    tSet<std::unique_ptr<tCountedElement>, tAllowDuplicates::NO, rrlib::thread::tMutex, set::storage::ArrayChunkBased<2, 6>> set;
+    std::vector<tCountedElement*> elements;
+    for (int i = 0; i < 10; i++)
+    {
+      std::unique_ptr<tCountedElement> element(new tCountedElement(i));
+      elements.push_back(element.get());
+      set.Add(std::move(element));
+    }
+
+    {
+      auto it = set.Begin();
+      while ((*it)->value != 3)
+      {
+        ++it;
+      }
+      set.Remove(it);
+      set.Remove(elements[4]);
+      set.Remove(elements[5]);
+      RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Elements must not be deleted while iterator exists", tCountedElement::deletions, 0);
+      RRLIB_UNIT_TESTS_EQUALITY((*it)->value, 3);
+    }
+
+    set.Remove(elements[6]);
+    set.Remove(elements[7]);
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Removed elements must be deleted after iterator has been destructed", tCountedElement::deletions > 0);
+    int remaining = 0;
+    for (auto it = set.Begin(); it != set.End(); ++it)
+    {
+      RRLIB_UNIT_TESTS_ASSERT((*it)->value < 3 || (*it)->value > 7);
+      remaining++;
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(remaining, 5);
+
+    auto handle = set.Add(std::unique_ptr<tCountedElement>(new tCountedElement(10)));
+    set.Remove(handle);
+    std::unique_ptr<tCountedElement> replacement(new tCountedElement(11));
+    tCountedElement* replacement_pointer = replacement.get();
+    set.Add(std::move(replacement));  // reuses slot
+    set.Remove(handle);
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Stale handle must not delete element in reused slot", set.Contains(replacement_pointer));
+    RRLIB_UNIT_TESTS_EQUALITY(replacement_pointer->value, 11);
+
+    set.Clear();
+    RRLIB_UNIT_TESTS_ASSERT(set.Empty());
+  }
+  RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("All elements must be deleted exactly once", tCountedElement::deletions, 12);
+}
+
+/*!
+ * Test ordered sets (set must be empty and order elements ascending)
+ */
+template <typename TSet>
+void TestOrdered(TSet& set)
+{
+  for (int i = 99; i > 0; i -= 2)
+  {
+    set.Add(i);
+  }
+  set.Add(50);
+  set.Add(51);  // already in set
+  std::vector<int> elements(set.Begin(), set.End());
+  RRLIB_UNIT_TESTS_EQUALITY(elements.size(), static_cast<size_t>(51));
+  RRLIB_UNIT_TESTS_ASSERT(std::is_sorted(elements.begin(), elements.end()));
+
+  RRLIB_UNIT_TESTS_EQUALITY(*set.LowerBound(50), 50);
+  RRLIB_UNIT_TESTS_EQUALITY(*set.LowerBound(52), 53);
+  RRLIB_UNIT_TESTS_ASSERT(set.LowerBound(100) == set.End());
+  int count = 0;
+  for (auto it = set.LowerBound(20); it != set.End() && *it < 30; ++it)
+  {
+    RRLIB_UNIT_TESTS_ASSERT((*it % 2) == 1);
+    count++;
+  }
+  RRLIB_UNIT_TESTS_EQUALITY(count, 5);
+}
+
+/*!
+ * Test concurrent adding and removing of elements (set must be empty)
+ */
+template <typename TSet>
+void TestConcurrentAddRemove(TSet& set)
+{
+  const int cTHREADS = 4;
+  const int cELEMENTS = 200;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < cTHREADS; t++)
+  {
+    threads.emplace_back([&set, t]()
+    {
+      for (int round = 0; round < 20; round++)
+      {
+        for (int i = 1; i <= cELEMENTS; i++)
+        {
+          set.Add(i);
+        }
+        for (int i = 1 + (t % 2); i <= cELEMENTS; i += 2)
+        {
+          set.Remove(i);
+        }
+        int previous = 0;
+        for (auto it = set.Begin(); it != set.End(); ++it)
+        {
+          RRLIB_UNIT_TESTS_ASSERT(*it > previous);
+          previous = *it;
+        }
+      }
+    });
+  }
+  for (auto it = threads.begin(); it != threads.end(); ++it)
+  {
+    it->join();
+  }
+  for (int i = 1; i <= cELEMENTS; i++)
+  {
+    set.Add(i);
+  }
+  std::vector<int> elements(set.Begin(), set.End());
+  RRLIB_UNIT_TESTS_EQUALITY(elements.size(), static_cast<size_t>(cELEMENTS));
+  set.Clear();
+  RRLIB_UNIT_TESTS_ASSERT(set.Empty());
+}
+
 class BasicSetTest : public util::tUnitTestSuite
 {
   RRLIB_UNIT_TESTS_BEGIN_SUITE(BasicSetTest);
@@ -138,19 +669,170 @@ class BasicSetTest : public util::tUnitTestSuite
       RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Testing tSet<int, tAllowDuplicates::NO, rrlib::thread::tMutex, set::storage::ArrayChunkBased<2, 6>>");
       tSet<int, tAllowDuplicates::NO, rrlib::thread::tMutex, set::storage::ArrayChunkBased<2, 6>> set;
       TestSet(set, false);
+      set.Clear();
+      TestBatchOperations(set, false);
+      set.Clear();
+      TestHandles(set);
+      set.Clear();
+      TestContains(set);
     }
 
     {
       RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Testing tSet<int, tAllowDuplicates::NO, rrlib::thread::tMutex, set::storage::ArrayChunkBased<2, 6, true>>");
       tSet<int, tAllowDuplicates::NO, rrlib::thread::tMutex, set::storage::ArrayChunkBased<2, 6, true>> set;
       TestSet(set, false);
+      set.Clear();
+      TestBatchOperations(set, false);
     }
 
     {
       RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Testing tSet<int, tAllowDuplicates::YES, rrlib::thread::tNoMutex, set::storage::ArrayChunkBased<4, 8>>");
       tSet<int, tAllowDuplicates::YES, rrlib::thread::tNoMutex, set::storage::ArrayChunkBased<4, 8>> set;
       TestSet(set, true);
+      set.Clear();
+      TestBatchOperations(set, true);
+    }
+
+    {
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Testing tSet<int, tAllowDuplicates::NO, rrlib::thread::tMutex, set::storage::ArrayChunkBased<2, 4, false, std::allocator<char>, 2>>");
+      tSet<int, tAllowDuplicates::NO, rrlib::thread::tMutex, set::storage::ArrayChunkBased<2, 4, false, std::allocator<char>, 2>> set;
+      TestSet(set, false);
+      set.Clear();
+      TestBatchOperations(set, false);
+      set.Clear();
+      TestParallelIteration(set);
+      set.Clear();
+      TestCopyTo(set);
+    }
+
+    {
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Testing tSet<int, tAllowDuplicates::NO, rrlib::thread::tMutex, set::storage::ArrayChunkBased<2, 6, false, tHugePageArenaAllocator<char>>>");
+      tSet<int, tAllowDuplicates::NO, rrlib::thread::tMutex, set::storage::ArrayChunkBased<2, 6, false, tHugePageArenaAllocator<char>>> set;
+      size_t arena_used = tHugePageArena::Default().GetStatistics().used;
+      TestSet(set, false);
+      RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Chunks must be allocated from arena", tHugePageArena::Default().GetStatistics().used > arena_used);
+      set.Clear();
+      TestBatchOperations(set, false);
+    }
+
+    {
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Testing tSet<int, tAllowDuplicates::YES, rrlib::thread::tNoMutex, set::storage::ArrayChunkBased<4, 2, true, std::allocator<char>, 3>>");
+      tSet<int, tAllowDuplicates::YES, rrlib::thread::tNoMutex, set::storage::ArrayChunkBased<4, 2, true, std::allocator<char>, 3>> set;
+      TestSet(set, true);
+      set.Clear();
+      TestBatchOperations(set, true);
+      set.Clear();
+      TestCopyTo(set);
     }
+
+    {
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Testing tSet<int, tAllowDuplicates::NO, rrlib::thread::tNoMutex, set::storage::LockFreeArrayChunkBased<2, 6>>");
+      tSet<int, tAllowDuplicates::NO, rrlib::thread::tNoMutex, set::storage::LockFreeArrayChunkBased<2, 6>> set;
+      TestSet(set, false);
+      set.Clear();
+      TestBatchOperations(set, false);
+      set.Clear();
+      TestHandles(set);
+      set.Clear();
+      TestContains(set);
+    }
+
+    {
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Testing tSet<int, tAllowDuplicates::NO, rrlib::thread::tNoMutex, set::storage::AtomicBitset<200>>");
+      tSet<int, tAllowDuplicates::NO, rrlib::thread::tNoMutex, set::storage::AtomicBitset<200>> set;
+      TestSet(set, false);
+      set.Clear();
+      TestBatchOperations(set, false);
+      set.Clear();
+      TestContains(set);
+      set.Add(150);
+      set.Add(199);
+      set.Add(200);  // outside of domain
+      std::vector<int> elements(set.Begin(), set.End());
+      RRLIB_UNIT_TESTS_ASSERT(elements == std::vector<int>({ 150, 199 }));
+      set.Remove(set.Add(64));
+      RRLIB_UNIT_TESTS_ASSERT(!set.Contains(64));
+    }
+
+    {
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Testing tSet<int, tAllowDuplicates::NO, rrlib::thread::tNoMutex, set::storage::SkipList<>>");
+      tSet<int, tAllowDuplicates::NO, rrlib::thread::tNoMutex, set::storage::SkipList<>> set;
+      TestSet(set, false);
+      set.Clear();
+      TestBatchOperations(set, false);
+      set.Clear();
+      TestContains(set);
+      set.Clear();
+      TestOrdered(set);
+    }
+
+    {
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Testing tSet<int, tAllowDuplicates::NO, rrlib::thread::tNoMutex, set::storage::SkipList<std::greater, 4>>");
+      tSet<int, tAllowDuplicates::NO, rrlib::thread::tNoMutex, set::storage::SkipList<std::greater, 4>> set;
+      for (int i = 1; i <= 100; i++)
+      {
+        set.Add(i);
+      }
+      std::vector<int> elements(set.Begin(), set.End());
+      RRLIB_UNIT_TESTS_ASSERT(std::is_sorted(elements.rbegin(), elements.rend()) && elements.size() == 100);
+      RRLIB_UNIT_TESTS_EQUALITY(*set.LowerBound(1000), 100);
+    }
+
+    {
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Testing tSet<int, tAllowDuplicates::YES, rrlib::thread::tNoMutex, set::storage::LockFreeArrayChunkBased<0, 8>>");
+      tSet<int, tAllowDuplicates::YES, rrlib::thread::tNoMutex, set::storage::LockFreeArrayChunkBased<0, 8>> set;
+      TestSet(set, true);
+    }
+
+    {
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Testing concurrent Add with tSet<int, tAllowDuplicates::NO, rrlib::thread::tNoMutex, set::storage::LockFreeArrayChunkBased<4, 16>>");
+      tSet<int, tAllowDuplicates::NO, rrlib::thread::tNoMutex, set::storage::LockFreeArrayChunkBased<4, 16>> set;
+      TestConcurrentAdd(set);
+    }
+
+    {
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Testing concurrent Add with tSet<int, tAllowDuplicates::NO, rrlib::thread::tNoMutex, set::storage::AtomicBitset<501>>");
+      tSet<int, tAllowDuplicates::NO, rrlib::thread::tNoMutex, set::storage::AtomicBitset<501>> set;
+      TestConcurrentAdd(set);
+    }
+
+    {
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Testing concurrent Add and Remove with tSet<int, tAllowDuplicates::NO, rrlib::thread::tNoMutex, set::storage::SkipList<>>");
+      tSet<int, tAllowDuplicates::NO, rrlib::thread::tNoMutex, set::storage::SkipList<>> set;
+      TestConcurrentAdd(set);
+      set.Clear();
+      TestConcurrentAddRemove(set);
+    }
+
+    {
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Testing change tracking with tSet<int, tAllowDuplicates::NO, rrlib::thread::tMutex, set::storage::ArrayChunkBased<4, 4, false, std::allocator<char>, 1, 8>>");
+      tSet<int, tAllowDuplicates::NO, rrlib::thread::tMutex, set::storage::ArrayChunkBased<4, 4, false, std::allocator<char>, 1, 8>> set;
+      TestChangeTracking(set);
+    }
+
+    {
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Testing concurrent Add with tSet<int, tAllowDuplicates::NO, tAdaptiveMutex, set::storage::ArrayChunkBased<4, 16>>");
+      tSet<int, tAllowDuplicates::NO, tAdaptiveMutex, set::storage::ArrayChunkBased<4, 16>> set;
+      TestConcurrentAdd(set);
+    }
+
+    {
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Testing parallel iteration with tSet<int, tAllowDuplicates::NO, rrlib::thread::tMutex, set::storage::ArrayChunkBased<4, 16>>");
+      tSet<int, tAllowDuplicates::NO, rrlib::thread::tMutex, set::storage::ArrayChunkBased<4, 16>> set;
+      TestParallelIteration(set);
+    }
+
+    {
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Testing consistent reads with tSet<int, tAllowDuplicates::NO, rrlib::thread::tMutex, set::storage::ArrayChunkBased<4, 16>>");
+      tSet<int, tAllowDuplicates::NO, rrlib::thread::tMutex, set::storage::ArrayChunkBased<4, 16>> set;
+      TestConsistentReads(set);
+    }
+
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Testing Reserve() with tSet<int, tAllowDuplicates::YES, rrlib::thread::tMutex, set::storage::ArrayChunkBased<2, 6, false, tCountingAllocator<char>>>");
+    TestReserve();
+
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Testing tSet<std::unique_ptr<tCountedElement>, tAllowDuplicates::NO, rrlib::thread::tMutex, set::storage::ArrayChunkBased<2, 6>>");
+    TestOwningSet();
   }
 
 };
@@ -0,0 +1,258 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/tests/byte_queue_test.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * Tests tByteQueue with single and multiple writers.
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages.h"
+#include "rrlib/util/tUnitTestSuite.h"
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tByteQueue.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+/*! Record with variable length: header followed by 'length' bytes with value 'writer + sequence_number' */
+struct tRecordHeader
+{
+  uint32_t writer;
+  uint32_t sequence_number;
+};
+
+size_t RecordLength(uint32_t sequence_number)
+{
+  return sizeof(tRecordHeader) + (sequence_number * 7) % 200;
+}
+
+template <tConcurrency CONCURRENCY>
+bool WriteRecord(tByteQueue<CONCURRENCY>& queue, uint32_t writer, uint32_t sequence_number)
+{
+  size_t length = RecordLength(sequence_number);
+  char* record = static_cast<char*>(queue.Reserve(length));
+  if (!record)
+  {
+    return false;
+  }
+  tRecordHeader header = { writer, sequence_number };
+  memcpy(record, &header, sizeof(header));
+  memset(record + sizeof(header), static_cast<char>(writer + sequence_number), length - sizeof(header));
+  queue.Commit(record);
+  return true;
+}
+
+template <tConcurrency CONCURRENCY>
+void TestConcurrentWriters(size_t writers)
+{
+  const uint32_t cRECORDS_PER_WRITER = 100000;
+  tByteQueue<CONCURRENCY> queue(4096);
+  std::vector<std::thread> threads;
+  for (size_t w = 0; w < writers; w++)
+  {
+    threads.emplace_back([&, w]()
+    {
+      for (uint32_t i = 0; i < cRECORDS_PER_WRITER; i++)
+      {
+        while (!WriteRecord(queue, w, i))
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  std::vector<uint32_t> next_sequence_number(writers, 0);
+  size_t received = 0;
+  bool valid = true;
+  while (received < writers * cRECORDS_PER_WRITER)
+  {
+    size_t size = 0;
+    const char* record = static_cast<const char*>(queue.Peek(size));
+    if (!record)
+    {
+      std::this_thread::yield();
+      continue;
+    }
+    tRecordHeader header;
+    memcpy(&header, record, sizeof(header));
+    valid &= header.writer < writers && header.sequence_number == next_sequence_number[header.writer];
+    valid &= size == RecordLength(header.sequence_number);
+    valid &= (reinterpret_cast<uintptr_t>(record) % tByteQueue<CONCURRENCY>::cRECORD_ALIGNMENT) == 0;
+    for (size_t i = sizeof(header); i < size; i++)
+    {
+      valid &= record[i] == static_cast<char>(header.writer + header.sequence_number);
+    }
+    if (header.writer < writers)
+    {
+      next_sequence_number[header.writer]++;
+    }
+    queue.Release();
+    received++;
+  }
+  for (auto & thread : threads)
+  {
+    thread.join();
+  }
+  RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Records must be received intact and in order of each writer", valid);
+  size_t size = 0;
+  RRLIB_UNIT_TESTS_ASSERT(!queue.Peek(size));
+}
+
+class ByteQueueTest : public util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(ByteQueueTest);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestSingleThreaded);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestOutOfOrderCommits);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestSingleWriter);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestMultipleWriters);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+  void TestSingleThreaded()
+  {
+    tByteQueue<tConcurrency::NONE> queue(512);
+    size_t size = 0;
+    RRLIB_UNIT_TESTS_ASSERT(!queue.Peek(size));
+    RRLIB_UNIT_TESTS_EQUALITY(queue.GetMaxRecordSize(), static_cast<size_t>(248));
+
+    // fill queue: records with 200 bytes occupy 208 bytes in ring
+    void* first = queue.Reserve(200);
+    queue.Commit(first);
+    void* second = queue.Reserve(200);
+    queue.Commit(second);
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Queue must be full", !queue.Reserve(200));
+    RRLIB_UNIT_TESTS_ASSERT(queue.Peek(size) == first && size == 200);
+    queue.Release();
+    RRLIB_UNIT_TESTS_ASSERT(queue.Peek(size) == second);
+    queue.Release();
+    RRLIB_UNIT_TESTS_ASSERT(!queue.Peek(size));
+    RRLIB_UNIT_TESTS_ASSERT(WriteRecord(queue, 0, 1));
+
+    // wrap around many times
+    for (uint32_t i = 1; i < 1000; i++)
+    {
+      const char* record = static_cast<const char*>(queue.Peek(size));
+      RRLIB_UNIT_TESTS_ASSERT(record);
+      tRecordHeader header;
+      memcpy(&header, record, sizeof(header));
+      RRLIB_UNIT_TESTS_EQUALITY(header.sequence_number, i);
+      RRLIB_UNIT_TESTS_EQUALITY(size, RecordLength(i));
+      RRLIB_UNIT_TESTS_ASSERT(queue.Peek(size) == record);
+      queue.Release();
+      RRLIB_UNIT_TESTS_ASSERT(WriteRecord(queue, 0, i + 1));
+    }
+
+    // empty records
+    tByteQueue<tConcurrency::NONE> small_queue(16);
+    for (int i = 0; i < 10; i++)
+    {
+      for (int j = 0; j < 2; j++)
+      {
+        void* record = small_queue.Reserve(0);
+        RRLIB_UNIT_TESTS_ASSERT(record);
+        small_queue.Commit(record);
+      }
+      RRLIB_UNIT_TESTS_ASSERT(!small_queue.Reserve(0));
+      for (int j = 0; j < 2; j++)
+      {
+        RRLIB_UNIT_TESTS_ASSERT(small_queue.Peek(size) && size == 0);
+        small_queue.Release();
+      }
+    }
+  }
+
+  void TestOutOfOrderCommits()
+  {
+    tByteQueue<tConcurrency::MULTIPLE_WRITERS> queue(1024);
+    size_t size = 0;
+    void* first = queue.Reserve(10);
+    void* second = queue.Reserve(20);
+    RRLIB_UNIT_TESTS_ASSERT(first && second && first != second);
+    queue.Commit(second);
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Records must be obtained in reservation order", !queue.Peek(size));
+    queue.Commit(first);
+    RRLIB_UNIT_TESTS_ASSERT(queue.Peek(size) == first && size == 10);
+    queue.Release();
+    RRLIB_UNIT_TESTS_ASSERT(queue.Peek(size) == second && size == 20);
+    queue.Release();
+    RRLIB_UNIT_TESTS_ASSERT(!queue.Peek(size));
+  }
+
+  void TestSingleWriter()
+  {
+    TestConcurrentWriters<tConcurrency::SINGLE_READER_AND_WRITER>(1);
+  }
+
+  void TestMultipleWriters()
+  {
+    TestConcurrentWriters<tConcurrency::MULTIPLE_WRITERS>(1);
+    TestConcurrentWriters<tConcurrency::MULTIPLE_WRITERS>(4);
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(ByteQueueTest);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,173 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/tests/concurrent_vector_test.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * Tests tConcurrentVector - including concurrent PushBack calls and readers.
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages.h"
+#include "rrlib/util/tUnitTestSuite.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tConcurrentVector.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+class ConcurrentVectorTest : public util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(ConcurrentVectorTest);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestBasics);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestConcurrentPushBack);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+  void TestBasics()
+  {
+    tConcurrentVector<std::string, 2> vector;
+    RRLIB_UNIT_TESTS_ASSERT(vector.Empty() && vector.Begin() == vector.End());
+    for (int i = 0; i < 100; i++)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(vector.PushBack(std::to_string(i)), static_cast<size_t>(i));
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(vector.Size(), static_cast<size_t>(100));
+    const std::string* address = &vector[50];
+    for (int i = 0; i < 1000; i++)
+    {
+      vector.EmplaceBack(3, 'x');
+    }
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Element addresses must be stable", address == &vector[50] && *address == "50");
+    for (int i = 0; i < 100; i++)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(vector[i], std::to_string(i));
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(vector[1099], std::string("xxx"));
+    RRLIB_UNIT_TESTS_EQUALITY(vector.End() - vector.Begin(), 1100);
+    const tConcurrentVector<std::string, 2>& const_vector = vector;
+    RRLIB_UNIT_TESTS_EQUALITY(std::count(const_vector.Begin(), const_vector.End(), "xxx"), 1000);
+
+    tConcurrentVector<std::unique_ptr<int>> owning_vector;
+    owning_vector.PushBack(std::unique_ptr<int>(new int(42)));
+    RRLIB_UNIT_TESTS_EQUALITY(*owning_vector[0], 42);
+  }
+
+  void TestConcurrentPushBack()
+  {
+    const int cTHREADS = 4;
+    const int cELEMENTS_PER_THREAD = 20000;
+    tConcurrentVector<std::pair<int, int>, 4> vector;
+    std::atomic<bool> stop(false);
+
+    std::thread reader([&vector, &stop]()
+    {
+      std::vector<int> last_element(cTHREADS, -1);
+      while (!stop.load())
+      {
+        std::fill(last_element.begin(), last_element.end(), -1);
+        for (auto it = vector.Begin(); it != vector.End(); ++it)
+        {
+          RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Elements of each thread must be in order", it->second > last_element[it->first]);
+          last_element[it->first] = it->second;
+        }
+      }
+    });
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < cTHREADS; t++)
+    {
+      writers.emplace_back([&vector, t]()
+      {
+        for (int i = 0; i < cELEMENTS_PER_THREAD; i++)
+        {
+          size_t index = vector.PushBack(std::pair<int, int>(t, i));
+          RRLIB_UNIT_TESTS_ASSERT(index < static_cast<size_t>(cTHREADS * cELEMENTS_PER_THREAD));
+        }
+      });
+    }
+    for (auto it = writers.begin(); it != writers.end(); ++it)
+    {
+      it->join();
+    }
+    stop = true;
+    reader.join();
+
+    RRLIB_UNIT_TESTS_EQUALITY(vector.Size(), static_cast<size_t>(cTHREADS * cELEMENTS_PER_THREAD));
+    std::vector<int> count(cTHREADS, 0);
+    for (auto it = vector.Begin(); it != vector.End(); ++it)
+    {
+      count[it->first]++;
+    }
+    for (int t = 0; t < cTHREADS; t++)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(count[t], cELEMENTS_PER_THREAD);
+    }
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(ConcurrentVectorTest);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
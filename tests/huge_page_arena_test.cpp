@@ -0,0 +1,151 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/tests/huge_page_arena_test.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * Tests tHugePageArena - and allocating queue elements from it.
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages.h"
+#include "rrlib/util/tUnitTestSuite.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tHugePageArena.h"
+#include "rrlib/concurrent_containers/tQueue.h"
+#include "rrlib/concurrent_containers/tSlabAllocator.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+struct tElement : public tQueueable<tQueueability::MOST>
+{
+  explicit tElement(int value) : value(value) {}
+
+  int value;
+};
+
+class HugePageArenaTest : public util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(HugePageArenaTest);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestAllocation);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestSlabAllocator);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+  void TestAllocation()
+  {
+    tHugePageArena arena(1000000);
+    tHugePageArena::tStatistics statistics = arena.GetStatistics();
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Capacity must be rounded up to huge page size", statistics.capacity >= 1000000 && (statistics.capacity % tHugePageArena::HugePageSize()) == 0);
+    RRLIB_UNIT_TESTS_EQUALITY(statistics.used, 0u);
+    RRLIB_LOG_PRINT(USER, "Arena: capacity ", statistics.capacity, " bytes, ", statistics.huge_page_bytes, " bytes in huge pages (explicit: ", statistics.explicit_huge_pages, ", locked: ", statistics.locked, ")");
+
+    std::vector<void*> blocks;
+    for (size_t size = 100; size <= 10000; size *= 3)
+    {
+      void* block = arena.Allocate(size);
+      RRLIB_UNIT_TESTS_ASSERT((reinterpret_cast<uintptr_t>(block) % tHugePageArena::cMIN_BLOCK_SIZE) == 0);
+      memset(block, 0xFF, size);
+      blocks.push_back(block);
+    }
+    size_t used = arena.GetStatistics().used;
+    for (size_t size = 100, i = 0; size <= 10000; size *= 3, i++)
+    {
+      arena.Deallocate(blocks[i], size);
+    }
+    for (size_t size = 100, i = 0; size <= 10000; size *= 3, i++)
+    {
+      RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Blocks of same size class must be reused", arena.Allocate(size) == blocks[i]);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(arena.GetStatistics().used, used);
+
+    bool exhausted = false;
+    try
+    {
+      arena.Allocate(statistics.capacity + 1);
+    }
+    catch (const std::bad_alloc&)
+    {
+      exhausted = true;
+    }
+    RRLIB_UNIT_TESTS_ASSERT(exhausted);
+  }
+
+  void TestSlabAllocator()
+  {
+    typedef tSlabAllocator<tElement, 64, 16, tHugePageArenaAllocator<char>> tElementAllocator;
+    size_t arena_used = tHugePageArena::Default().GetStatistics().used;
+    tQueue<tElementAllocator::tPointer, tConcurrency::MULTIPLE_WRITERS, tDequeueMode::ALL> queue;
+    for (int i = 0; i < 1000; i++)
+    {
+      queue.Enqueue(tElementAllocator::Create(i));
+    }
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Slabs must be allocated from arena", tHugePageArena::Default().GetStatistics().used > arena_used);
+    tQueueFragment<tElementAllocator::tPointer> fragment = queue.DequeueAll();
+    RRLIB_UNIT_TESTS_EQUALITY(fragment.PopFront()->value, 0);
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(HugePageArenaTest);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,261 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/tests/indexed_queue_test.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * Tests queues with elements that are linked via 32-bit indices (tQueueability::INDEXED).
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages.h"
+#include "rrlib/util/tUnitTestSuite.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tIndexedArena.h"
+#include "rrlib/concurrent_containers/tQueue.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+/*! Number of existing test elements */
+std::atomic<int> existing_elements(0);
+
+struct tFirstBaseClass
+{
+  int64_t an_integer;
+};
+
+struct tIndexedTestType : public tFirstBaseClass, public tQueueable<tQueueability::INDEXED>
+{
+  explicit tIndexedTestType(int value) : value(value)
+  {
+    existing_elements++;
+  }
+  ~tIndexedTestType()
+  {
+    existing_elements--;
+  }
+
+  int value;
+};
+
+typedef tIndexedArena<tIndexedTestType, 100000> tTestArena;
+
+static_assert(sizeof(tQueueable<tQueueability::INDEXED>) == 4, "Index link should have 32 bits");
+
+template <tConcurrency CONCURRENCY, tDequeueMode DEQUEUE_MODE>
+void TestFifo()
+{
+  tQueue<tTestArena::tPointer, CONCURRENCY, DEQUEUE_MODE> queue;
+  RRLIB_UNIT_TESTS_ASSERT(!queue.Dequeue());
+  for (int i = 1; i <= 10; i++)
+  {
+    queue.Enqueue(tTestArena::Create(i));
+  }
+  for (int i = 1; i <= 5; i++)
+  {
+    tTestArena::tPointer element = queue.Dequeue();
+    RRLIB_UNIT_TESTS_EQUALITY(element->value, i);
+    queue.Enqueue(element);
+  }
+  for (int i = 6; i <= 15; i++)
+  {
+    bool success = false;
+    tTestArena::tPointer element = queue.Dequeue(success);
+    RRLIB_UNIT_TESTS_ASSERT(success);
+    RRLIB_UNIT_TESTS_EQUALITY(element->value, i <= 10 ? i : i - 10);
+  }
+  RRLIB_UNIT_TESTS_ASSERT(!queue.Dequeue());
+
+  for (int i = 0; i < 5; i++)
+  {
+    queue.Enqueue(tTestArena::Create(i + 100));
+    RRLIB_UNIT_TESTS_EQUALITY(queue.Dequeue()->value, i + 100);
+  }
+  queue.Enqueue(tTestArena::Create(0));  // deleted with queue
+}
+
+template <tConcurrency CONCURRENCY>
+void TestBounded(int max_length)
+{
+  tQueue<tTestArena::tPointer, CONCURRENCY, tDequeueMode::FIFO, true> queue;
+  queue.SetMaxLength(max_length);
+  RRLIB_UNIT_TESTS_EQUALITY(queue.GetMaxLength(), max_length);
+  for (int i = 0; i < 100; i++)
+  {
+    queue.Enqueue(tTestArena::Create(i));
+  }
+  std::vector<int> values;
+  while (tTestArena::tPointer element = queue.Dequeue())
+  {
+    values.push_back(element->value);
+  }
+  RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Elements must only be discarded if queue exceeds maximum length", static_cast<int>(values.size()) >= max_length);
+  RRLIB_UNIT_TESTS_ASSERT(static_cast<int>(values.size()) <= max_length + 1);
+  for (size_t i = 0; i < values.size(); i++)
+  {
+    RRLIB_UNIT_TESTS_EQUALITY(values[i], 100 - static_cast<int>(values.size()) + static_cast<int>(i));
+  }
+}
+
+class IndexedQueueTest : public util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(IndexedQueueTest);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestArena);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestQueues);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestBoundedQueues);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestConcurrentQueue);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+  void TestArena()
+  {
+    tIndexedTestType* address = NULL;
+    uint32_t index = 0;
+    {
+      tTestArena::tPointer element = tTestArena::Create(1);
+      address = element.get();
+      index = tTestArena::GetIndex(address);
+      RRLIB_UNIT_TESTS_ASSERT(tTestArena::Element(index) == address);
+    }
+    tTestArena::tPointer element = tTestArena::Create(2);
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Freed block must be reused", element.get() == address && tTestArena::GetIndex(element.get()) == index);
+  }
+
+  void TestQueues()
+  {
+    TestFifo<tConcurrency::NONE, tDequeueMode::FIFO>();
+    TestFifo<tConcurrency::SINGLE_READER_AND_WRITER, tDequeueMode::FIFO>();
+    TestFifo<tConcurrency::SINGLE_READER_AND_WRITER, tDequeueMode::FIFO_FAST>();
+    TestFifo<tConcurrency::MULTIPLE_WRITERS, tDequeueMode::FIFO>();
+    TestFifo<tConcurrency::MULTIPLE_READERS, tDequeueMode::FIFO>();
+    TestFifo<tConcurrency::FULL, tDequeueMode::FIFO>();
+    RRLIB_UNIT_TESTS_EQUALITY(existing_elements.load(), 0);
+  }
+
+  void TestBoundedQueues()
+  {
+    TestBounded<tConcurrency::SINGLE_READER_AND_WRITER>(1);
+    TestBounded<tConcurrency::SINGLE_READER_AND_WRITER>(5);
+    TestBounded<tConcurrency::MULTIPLE_WRITERS>(2);
+    TestBounded<tConcurrency::FULL>(10);
+    RRLIB_UNIT_TESTS_EQUALITY(existing_elements.load(), 0);
+
+    tQueue<tTestArena::tPointer, tConcurrency::NONE, tDequeueMode::FIFO, true> queue;
+    queue.SetMaxLength(1000000);
+    RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Maximum lengths beyond 500000 are possible", queue.GetMaxLength(), 1000000);
+    for (int i = 0; i < 10; i++)
+    {
+      queue.Enqueue(tTestArena::Create(i));
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(queue.Size(), 10);
+    queue.Dequeue();
+    RRLIB_UNIT_TESTS_EQUALITY(queue.Size(), 9);
+    queue.SetMaxLength(3);
+    RRLIB_UNIT_TESTS_ASSERT(queue.Size() >= 3 && queue.Size() <= 4);
+  }
+
+  void TestConcurrentQueue()
+  {
+    const int cTHREADS = 4;
+    const int cELEMENTS_PER_THREAD = 20000;
+    tQueue<tTestArena::tPointer, tConcurrency::FULL, tDequeueMode::FIFO> queue;
+    std::vector<std::atomic<int>> received(cTHREADS * cELEMENTS_PER_THREAD);
+    std::atomic<int> received_count(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < cTHREADS; t++)
+    {
+      threads.emplace_back([&, t]()
+      {
+        for (int i = 0; i < cELEMENTS_PER_THREAD; i++)
+        {
+          queue.Enqueue(tTestArena::Create(t * cELEMENTS_PER_THREAD + i));
+        }
+      });
+      threads.emplace_back([&]()
+      {
+        while (received_count.load() < cTHREADS * cELEMENTS_PER_THREAD)
+        {
+          tTestArena::tPointer element = queue.Dequeue();
+          if (element)
+          {
+            received[element->value]++;
+            received_count++;
+          }
+        }
+      });
+    }
+    for (auto & thread : threads)
+    {
+      thread.join();
+    }
+    for (auto & count : received)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(count.load(), 1);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(existing_elements.load(), 0);
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(IndexedQueueTest);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
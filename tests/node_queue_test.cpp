@@ -0,0 +1,268 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/tests/node_queue_test.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * Tests queues with unique pointers to types that are not derived from tQueueable.
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages.h"
+#include "rrlib/util/tUnitTestSuite.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tQueue.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+/*! Number of existing buffers */
+std::atomic<int> existing_buffers(0);
+
+/*! Number of buffers deleted with custom deleter */
+std::atomic<int> custom_deletions(0);
+
+/*! Type that cannot be derived from tQueueable (e.g. from a third-party library) */
+struct tThirdPartyBuffer
+{
+  explicit tThirdPartyBuffer(int value) : value(value)
+  {
+    existing_buffers++;
+  }
+  ~tThirdPartyBuffer()
+  {
+    existing_buffers--;
+  }
+
+  int value;
+};
+
+struct tCustomDeleter
+{
+  void operator()(tThirdPartyBuffer* buffer) const
+  {
+    custom_deletions++;
+    delete buffer;
+  }
+};
+
+typedef std::unique_ptr<tThirdPartyBuffer> tPointer;
+
+template <tConcurrency CONCURRENCY, tDequeueMode DEQUEUE_MODE>
+void TestFifo()
+{
+  tQueue<tPointer, CONCURRENCY, DEQUEUE_MODE> queue;
+  RRLIB_UNIT_TESTS_ASSERT(!queue.Dequeue());
+  for (int i = 1; i <= 200; i++)
+  {
+    queue.Enqueue(tPointer(new tThirdPartyBuffer(i)));
+  }
+  for (int i = 1; i <= 5; i++)
+  {
+    tPointer element = queue.Dequeue();
+    RRLIB_UNIT_TESTS_EQUALITY(element->value, i);
+    queue.Enqueue(element);
+  }
+  for (int i = 6; i <= 205 - queue.cMINIMUM_ELEMENTS_IN_QEUEUE; i++)
+  {
+    bool success = false;
+    tPointer element = queue.Dequeue(success);
+    RRLIB_UNIT_TESTS_ASSERT(success);
+    RRLIB_UNIT_TESTS_EQUALITY(element->value, i <= 200 ? i : i - 200);
+  }
+  queue.Enqueue(tPointer(new tThirdPartyBuffer(0)));  // deleted with queue
+}
+
+template <tConcurrency CONCURRENCY, bool BOUNDED>
+void TestDequeueAll()
+{
+  tQueueFragment<tPointer> outliving_fragment;
+  {
+    tQueue<tPointer, CONCURRENCY, tDequeueMode::ALL, BOUNDED> queue;
+    for (int i = 0; i < 10; i++)
+    {
+      queue.Enqueue(tPointer(new tThirdPartyBuffer(i)));
+    }
+    tQueueFragment<tPointer> fragment = queue.DequeueAll();
+    for (int i = 0; i < 10; i++)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(fragment.PopFront()->value, i);
+    }
+    RRLIB_UNIT_TESTS_ASSERT(fragment.Empty() && !fragment.PopAny());
+
+    for (int i = 0; i < 3; i++)
+    {
+      queue.Enqueue(tPointer(new tThirdPartyBuffer(i)));
+    }
+    outliving_fragment = queue.DequeueAll();
+    queue.Enqueue(tPointer(new tThirdPartyBuffer(0)));  // deleted with queue
+  }
+  RRLIB_UNIT_TESTS_EQUALITY(outliving_fragment.PopBack()->value, 2);
+  RRLIB_UNIT_TESTS_EQUALITY(existing_buffers.load(), 2);
+}
+
+class NodeQueueTest : public util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(NodeQueueTest);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestQueues);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestBoundedQueues);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestCustomDeleter);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestConcurrentQueue);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+  void TestQueues()
+  {
+    TestFifo<tConcurrency::NONE, tDequeueMode::FIFO>();
+    TestFifo<tConcurrency::SINGLE_READER_AND_WRITER, tDequeueMode::FIFO>();
+    TestFifo<tConcurrency::SINGLE_READER_AND_WRITER, tDequeueMode::FIFO_FAST>();
+    TestFifo<tConcurrency::MULTIPLE_WRITERS, tDequeueMode::FIFO>();
+    TestFifo<tConcurrency::MULTIPLE_READERS, tDequeueMode::FIFO_FAST>();
+    TestFifo<tConcurrency::FULL, tDequeueMode::FIFO>();
+    TestDequeueAll<tConcurrency::NONE, false>();
+    TestDequeueAll<tConcurrency::MULTIPLE_WRITERS, false>();
+    TestDequeueAll<tConcurrency::FULL, true>();
+    RRLIB_UNIT_TESTS_EQUALITY(existing_buffers.load(), 0);
+  }
+
+  void TestBoundedQueues()
+  {
+    tQueue<tPointer, tConcurrency::FULL, tDequeueMode::FIFO, true> queue;
+    queue.SetMaxLength(5);
+    RRLIB_UNIT_TESTS_EQUALITY(queue.GetMaxLength(), 5);
+    for (int i = 0; i < 100; i++)
+    {
+      queue.Enqueue(tPointer(new tThirdPartyBuffer(i)));
+    }
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Discarded elements must be deleted", existing_buffers.load() <= 6);
+    tPointer element = queue.Dequeue();
+    RRLIB_UNIT_TESTS_ASSERT(element->value >= 94);
+
+    tQueue<tPointer, tConcurrency::NONE, tDequeueMode::FIFO, true> single_threaded_queue;
+    single_threaded_queue.SetMaxLength(3);
+    for (int i = 0; i < 10; i++)
+    {
+      single_threaded_queue.Enqueue(tPointer(new tThirdPartyBuffer(i)));
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(single_threaded_queue.Size(), 3);
+    RRLIB_UNIT_TESTS_EQUALITY(single_threaded_queue.Dequeue()->value, 7);
+  }
+
+  void TestCustomDeleter()
+  {
+    {
+      tQueue<std::unique_ptr<tThirdPartyBuffer, tCustomDeleter>, tConcurrency::MULTIPLE_WRITERS, tDequeueMode::FIFO> queue;
+      for (int i = 0; i < 10; i++)
+      {
+        queue.Enqueue(std::unique_ptr<tThirdPartyBuffer, tCustomDeleter>(new tThirdPartyBuffer(i)));
+      }
+      queue.Dequeue();
+    }
+    RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Elements must be deleted with the queue's deleter", custom_deletions.load(), 10);
+    RRLIB_UNIT_TESTS_EQUALITY(existing_buffers.load(), 0);
+  }
+
+  void TestConcurrentQueue()
+  {
+    const int cTHREADS = 4;
+    const int cELEMENTS_PER_THREAD = 20000;
+    tQueue<tPointer, tConcurrency::FULL, tDequeueMode::FIFO> queue;
+    std::vector<std::atomic<int>> received(cTHREADS * cELEMENTS_PER_THREAD);
+    std::atomic<int> received_count(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < cTHREADS; t++)
+    {
+      threads.emplace_back([&, t]()
+      {
+        for (int i = 0; i < cELEMENTS_PER_THREAD; i++)
+        {
+          queue.Enqueue(tPointer(new tThirdPartyBuffer(t * cELEMENTS_PER_THREAD + i)));
+        }
+      });
+      threads.emplace_back([&]()
+      {
+        while (received_count.load() < cTHREADS * cELEMENTS_PER_THREAD)
+        {
+          tPointer element = queue.Dequeue();
+          if (element)
+          {
+            received[element->value]++;
+            received_count++;
+          }
+        }
+      });
+    }
+    for (auto & thread : threads)
+    {
+      thread.join();
+    }
+    for (auto & count : received)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(count.load(), 1);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(existing_buffers.load(), 0);
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(NodeQueueTest);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
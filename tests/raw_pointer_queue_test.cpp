@@ -0,0 +1,271 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/tests/raw_pointer_queue_test.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * Tests queues with raw pointers to externally managed objects.
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages.h"
+#include "rrlib/util/tUnitTestSuite.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tQueue.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+enum { cELEMENTS = 200 };
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+template <tQueueability QUEUEABILITY>
+struct tElement : public tQueueable<QUEUEABILITY>
+{
+  int value;
+};
+
+// bounded fragment queues with tQueueability::MOST_OPTIMIZED are blocking - and need to be enabled explicitly
+template <>
+struct tAllowBlockingBoundedFragmentQueue<tElement<tQueueability::MOST_OPTIMIZED>> : std::true_type
+{};
+
+/*! Elements in static tables (deleting them would crash) */
+tElement<tQueueability::MOST_OPTIMIZED> elements[cELEMENTS];
+tElement<tQueueability::FULL> full_elements[cELEMENTS];
+tElement<tQueueability::SINGLE_THREADED> single_threaded_elements[cELEMENTS];
+
+template <tConcurrency CONCURRENCY, tDequeueMode DEQUEUE_MODE, tQueueability QUEUEABILITY>
+void TestFifo(tElement<QUEUEABILITY>* table)
+{
+  typedef tElement<QUEUEABILITY> tElementType;
+  {
+    // queue is deleted with elements enqueued - elements must stay intact and be reusable
+    tQueue<tElementType*, CONCURRENCY, DEQUEUE_MODE> queue;
+    for (int i = 0; i < cELEMENTS; i++)
+    {
+      queue.Enqueue(&table[i]);
+    }
+    queue.Dequeue();
+  }
+
+  tQueue<tElementType*, CONCURRENCY, DEQUEUE_MODE> queue;
+  RRLIB_UNIT_TESTS_ASSERT(!queue.Dequeue());
+  for (int i = 0; i < cELEMENTS; i++)
+  {
+    table[i].value = i;
+    queue.Enqueue(&table[i]);
+  }
+  for (int i = 0; i < 5; i++)
+  {
+    tElementType* element = queue.Dequeue();
+    RRLIB_UNIT_TESTS_ASSERT(element == &table[i]);
+    queue.Enqueue(element);
+  }
+  for (int i = 5; i < cELEMENTS + 5 - queue.cMINIMUM_ELEMENTS_IN_QEUEUE; i++)
+  {
+    bool success = false;
+    tElementType* element = queue.Dequeue(success);
+    RRLIB_UNIT_TESTS_ASSERT(success);
+    RRLIB_UNIT_TESTS_EQUALITY(element->value, i % cELEMENTS);
+  }
+}
+
+template <tConcurrency CONCURRENCY, bool BOUNDED, tQueueability QUEUEABILITY>
+void TestDequeueAll(tElement<QUEUEABILITY>* table)
+{
+  typedef tElement<QUEUEABILITY> tElementType;
+  tQueue<tElementType*, CONCURRENCY, tDequeueMode::ALL, BOUNDED> queue;
+  {
+    // fragment is deleted with elements left - elements must stay intact and be reusable
+    for (int i = 0; i < cELEMENTS; i++)
+    {
+      queue.Enqueue(&table[i]);
+    }
+    tQueueFragment<tElementType*> fragment = queue.DequeueAll();
+    fragment.PopFront();
+  }
+
+  for (int i = 0; i < 10; i++)
+  {
+    table[i].value = i;
+    queue.Enqueue(&table[i]);
+  }
+  tQueueFragment<tElementType*> fragment = queue.DequeueAll();
+  for (int i = 0; i < 10; i++)
+  {
+    RRLIB_UNIT_TESTS_ASSERT(fragment.PopFront() == &table[i]);
+  }
+  RRLIB_UNIT_TESTS_ASSERT(fragment.Empty() && !fragment.PopAny());
+
+  for (int i = 0; i < 3; i++)
+  {
+    queue.Enqueue(&table[i]);
+  }
+  fragment = queue.DequeueAll();
+  RRLIB_UNIT_TESTS_EQUALITY(fragment.PopBack()->value, 2);
+  queue.Enqueue(&table[0]);
+}
+
+class RawPointerQueueTest : public util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(RawPointerQueueTest);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestQueues);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestBoundedQueues);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestConcurrentQueue);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+  void TestQueues()
+  {
+    TestFifo<tConcurrency::NONE, tDequeueMode::FIFO>(elements);
+    TestFifo<tConcurrency::NONE, tDequeueMode::FIFO>(single_threaded_elements);
+    TestFifo<tConcurrency::SINGLE_READER_AND_WRITER, tDequeueMode::FIFO>(elements);
+    TestFifo<tConcurrency::SINGLE_READER_AND_WRITER, tDequeueMode::FIFO_FAST>(elements);
+    TestFifo<tConcurrency::MULTIPLE_WRITERS, tDequeueMode::FIFO>(elements);
+    TestFifo<tConcurrency::MULTIPLE_READERS, tDequeueMode::FIFO_FAST>(elements);
+    TestFifo<tConcurrency::FULL, tDequeueMode::FIFO>(elements);
+    TestFifo<tConcurrency::FULL, tDequeueMode::FIFO_FAST>(full_elements);
+    TestDequeueAll<tConcurrency::NONE, false>(elements);
+    TestDequeueAll<tConcurrency::NONE, true>(elements);
+    TestDequeueAll<tConcurrency::NONE, false>(single_threaded_elements);
+    TestDequeueAll<tConcurrency::MULTIPLE_WRITERS, false>(elements);
+    TestDequeueAll<tConcurrency::FULL, true>(elements);
+    TestDequeueAll<tConcurrency::FULL, true>(full_elements);
+  }
+
+  void TestBoundedQueues()
+  {
+    tQueue<tElement<tQueueability::MOST_OPTIMIZED>*, tConcurrency::FULL, tDequeueMode::FIFO, true> queue;
+    queue.SetMaxLength(5);
+    RRLIB_UNIT_TESTS_EQUALITY(queue.GetMaxLength(), 5);
+    for (int i = 0; i < cELEMENTS; i++)
+    {
+      elements[i].value = i;
+      queue.Enqueue(&elements[i]);
+    }
+    RRLIB_UNIT_TESTS_ASSERT(queue.Dequeue()->value >= cELEMENTS - 6);
+
+    tQueue<tElement<tQueueability::MOST_OPTIMIZED>*, tConcurrency::NONE, tDequeueMode::FIFO, true> single_threaded_queue;
+    single_threaded_queue.SetMaxLength(3);
+    for (int i = 0; i < 10; i++)
+    {
+      single_threaded_queue.Enqueue(&elements[i]);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(single_threaded_queue.Size(), 3);
+    RRLIB_UNIT_TESTS_EQUALITY(single_threaded_queue.Dequeue()->value, 7);
+  }
+
+  void TestConcurrentQueue()
+  {
+    // elements circulate between two queues
+    const int cTHREADS = 4;
+    const int cITERATIONS = 50000;
+    typedef tElement<tQueueability::MOST_OPTIMIZED> tElementType;
+    tQueue<tElementType*, tConcurrency::FULL, tDequeueMode::FIFO> queue1, queue2;
+    for (int i = 0; i < cELEMENTS; i++)
+    {
+      elements[i].value = 0;
+      queue1.Enqueue(&elements[i]);
+    }
+    std::atomic<int> transfers(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < cTHREADS; t++)
+    {
+      threads.emplace_back([&, t]()
+      {
+        auto& source = (t % 2) ? queue1 : queue2;
+        auto& destination = (t % 2) ? queue2 : queue1;
+        for (int i = 0; i < cITERATIONS; i++)
+        {
+          tElementType* element = source.Dequeue();
+          if (element)
+          {
+            element->value++;
+            destination.Enqueue(element);
+            transfers++;
+          }
+        }
+      });
+    }
+    for (auto & thread : threads)
+    {
+      thread.join();
+    }
+    int sum = 0;
+    int count = 0;
+    for (tElementType* element = queue1.Dequeue(); element; element = queue1.Dequeue())
+    {
+      sum += element->value;
+      count++;
+    }
+    for (tElementType* element = queue2.Dequeue(); element; element = queue2.Dequeue())
+    {
+      sum += element->value;
+      count++;
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(count, cELEMENTS - queue1.cMINIMUM_ELEMENTS_IN_QEUEUE - queue2.cMINIMUM_ELEMENTS_IN_QEUEUE);
+    RRLIB_UNIT_TESTS_ASSERT(sum <= transfers.load());
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(RawPointerQueueTest);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,223 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/tests/recycling_pool_test.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * Tests tRecyclingPool - with elements that are returned from consumer threads.
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages.h"
+#include "rrlib/util/tUnitTestSuite.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tQueue.h"
+#include "rrlib/concurrent_containers/tRecyclingPool.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+/*! Number of existing buffer objects */
+std::atomic<int> existing_buffers(0);
+
+struct tBuffer : public tRecyclable<>
+{
+  tBuffer() : value(0)
+  {
+    existing_buffers++;
+  }
+  ~tBuffer()
+  {
+    existing_buffers--;
+  }
+
+  int value;
+};
+
+typedef tRecyclingPool<tBuffer> tBufferPool;
+
+class RecyclingPoolTest : public util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(RecyclingPoolTest);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestReuse);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestProducerConsumer);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestRecycleFragments);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestElementsOutlivingPool);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+  void TestReuse()
+  {
+    {
+      tBufferPool pool;
+      RRLIB_UNIT_TESTS_ASSERT(!pool.GetUnused());
+      tBuffer* address = NULL;
+      {
+        tBufferPool::tPointer buffer = pool.Create();
+        buffer->value = 42;
+        address = buffer.get();
+      }
+      RRLIB_UNIT_TESTS_EQUALITY(existing_buffers.load(), 1);
+      tBufferPool::tPointer buffer = pool.GetUnused();
+      RRLIB_UNIT_TESTS_ASSERT(buffer.get() == address);
+      RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Elements must be returned as they are", buffer->value, 42);
+      RRLIB_UNIT_TESTS_ASSERT(!pool.GetUnused());
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(existing_buffers.load(), 0);
+  }
+
+  void TestProducerConsumer()
+  {
+    const int cBUFFERS = 100000;
+    {
+      tBufferPool pool;
+      tQueue<tBufferPool::tPointer, tConcurrency::SINGLE_READER_AND_WRITER, tDequeueMode::FIFO> queue;
+      std::atomic<int> created(0);
+
+      std::thread producer([&]()
+      {
+        for (int i = 0; i < cBUFFERS; i++)
+        {
+          tBufferPool::tPointer buffer = pool.GetUnused();
+          while ((!buffer) && created.load() >= 100)
+          {
+            std::this_thread::yield();
+            buffer = pool.GetUnused();
+          }
+          if (!buffer)
+          {
+            buffer = pool.Create();
+            created++;
+          }
+          buffer->value = i;
+          queue.Enqueue(std::move(buffer));
+        }
+      });
+
+      int expected = 0;
+      while (expected < cBUFFERS)
+      {
+        tBufferPool::tPointer buffer = queue.Dequeue();
+        if (buffer)
+        {
+          RRLIB_UNIT_TESTS_EQUALITY(buffer->value, expected);
+          expected++;
+        }
+      }
+      producer.join();
+      RRLIB_UNIT_TESTS_ASSERT(created.load() <= 100);
+      RRLIB_UNIT_TESTS_EQUALITY(existing_buffers.load(), created.load());
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(existing_buffers.load(), 0);
+  }
+
+  void TestRecycleFragments()
+  {
+    tBufferPool pool1, pool2;
+    tQueue<tBufferPool::tPointer, tConcurrency::MULTIPLE_WRITERS, tDequeueMode::ALL> queue;
+    for (int i = 0; i < 30; i++)
+    {
+      queue.Enqueue((i / 10) == 1 ? pool2.Create() : pool1.Create());
+    }
+    tQueueFragment<tBufferPool::tPointer> fragment = queue.DequeueAll();
+    tBufferPool::Recycle(fragment);
+    RRLIB_UNIT_TESTS_ASSERT(fragment.Empty());
+    RRLIB_UNIT_TESTS_EQUALITY(existing_buffers.load(), 30);
+
+    std::vector<tBufferPool::tPointer> unused1, unused2;
+    while (tBufferPool::tPointer buffer = pool1.GetUnused())
+    {
+      unused1.push_back(std::move(buffer));
+    }
+    while (tBufferPool::tPointer buffer = pool2.GetUnused())
+    {
+      unused2.push_back(std::move(buffer));
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(unused1.size(), 20u);
+    RRLIB_UNIT_TESTS_EQUALITY(unused2.size(), 10u);
+  }
+
+  void TestElementsOutlivingPool()
+  {
+    tQueue<tBufferPool::tPointer, tConcurrency::MULTIPLE_WRITERS, tDequeueMode::ALL> queue;
+    {
+      tBufferPool pool;
+      for (int i = 0; i < 10; i++)
+      {
+        queue.Enqueue(pool.Create());
+      }
+      pool.Create();
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(existing_buffers.load(), 10);
+    std::thread consumer([&queue]()
+    {
+      tQueueFragment<tBufferPool::tPointer> fragment = queue.DequeueAll();
+      tBufferPool::Recycle(fragment);
+    });
+    consumer.join();
+    RRLIB_UNIT_TESTS_EQUALITY(existing_buffers.load(), 0);
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(RecyclingPoolTest);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
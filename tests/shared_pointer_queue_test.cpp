@@ -0,0 +1,257 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/tests/shared_pointer_queue_test.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * Tests distributing objects to several queues with tQueueableSharedPointer.
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages.h"
+#include "rrlib/util/tUnitTestSuite.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tQueue.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+/*! Number of existing buffers */
+std::atomic<int> existing_buffers(0);
+
+struct tBuffer : public tSharedQueueable<3>
+{
+  explicit tBuffer(int value) : value(value)
+  {
+    existing_buffers++;
+  }
+  ~tBuffer()
+  {
+    existing_buffers--;
+  }
+
+  int value;
+};
+
+struct tFullBuffer : public tSharedQueueable<2, tQueueability::FULL>
+{
+  explicit tFullBuffer(int value) : value(value)
+  {
+    existing_buffers++;
+  }
+  ~tFullBuffer()
+  {
+    existing_buffers--;
+  }
+
+  int value;
+};
+
+static_assert(sizeof(tQueueableSharedPointer<tBuffer, 2>) == sizeof(void*), "Shared pointer must have the size of a raw pointer");
+
+class SharedPointerQueueTest : public util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(SharedPointerQueueTest);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestPointer);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestFanOut);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestBoundedQueues);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestConcurrentFanOut);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+  void TestPointer()
+  {
+    {
+      tQueueableSharedPointer<tBuffer> pointer(new tBuffer(1));
+      RRLIB_UNIT_TESTS_EQUALITY(pointer.GetReferenceCount(), 1u);
+      tQueueableSharedPointer<tBuffer, 1> copy(pointer);
+      RRLIB_UNIT_TESTS_ASSERT(copy.get() == pointer.get());
+      RRLIB_UNIT_TESTS_EQUALITY(pointer.GetReferenceCount(), 2u);
+      tQueueableSharedPointer<tBuffer> moved(std::move(pointer));
+      RRLIB_UNIT_TESTS_ASSERT(!pointer);
+      RRLIB_UNIT_TESTS_EQUALITY(moved.GetReferenceCount(), 2u);
+      moved.reset();
+      RRLIB_UNIT_TESTS_EQUALITY(existing_buffers.load(), 1);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(existing_buffers.load(), 0);
+  }
+
+  void TestFanOut()
+  {
+    tQueue<tQueueableSharedPointer<tBuffer, 0>, tConcurrency::SINGLE_READER_AND_WRITER, tDequeueMode::FIFO> queue0;
+    tQueue<tQueueableSharedPointer<tBuffer, 1>, tConcurrency::MULTIPLE_WRITERS, tDequeueMode::FIFO_FAST> queue1;
+    tQueue<tQueueableSharedPointer<tBuffer, 2>, tConcurrency::FULL, tDequeueMode::ALL> queue2;
+    for (int i = 0; i < 10; i++)
+    {
+      tQueueableSharedPointer<tBuffer> buffer(new tBuffer(i));
+      queue1.Enqueue(tQueueableSharedPointer<tBuffer, 1>(buffer));
+      queue2.Enqueue(tQueueableSharedPointer<tBuffer, 2>(buffer));
+      queue0.Enqueue(buffer);
+      RRLIB_UNIT_TESTS_ASSERT(!buffer);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Objects must not be copied", existing_buffers.load(), 10);
+
+    for (int i = 0; i < 10; i++)
+    {
+      tQueueableSharedPointer<tBuffer, 0> buffer = queue0.Dequeue();
+      RRLIB_UNIT_TESTS_EQUALITY(buffer->value, i);
+      RRLIB_UNIT_TESTS_EQUALITY(buffer.GetReferenceCount(), 3u);
+    }
+    RRLIB_UNIT_TESTS_ASSERT(!queue0.Dequeue());
+    tQueueFragment<tQueueableSharedPointer<tBuffer, 2>> fragment = queue2.DequeueAll();
+    for (int i = 0; i < 10; i++)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(fragment.PopFront()->value, i);
+    }
+    for (int i = 0; i < 10 - queue1.cMINIMUM_ELEMENTS_IN_QEUEUE; i++)
+    {
+      tQueueableSharedPointer<tBuffer, 1> buffer = queue1.Dequeue();
+      RRLIB_UNIT_TESTS_EQUALITY(buffer->value, i);
+      RRLIB_UNIT_TESTS_EQUALITY(buffer.GetReferenceCount(), 1u);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(existing_buffers.load(), queue1.cMINIMUM_ELEMENTS_IN_QEUEUE);
+
+    // object in several queues when queues are deleted
+    tQueueableSharedPointer<tBuffer> buffer(new tBuffer(0));
+    queue0.Enqueue(tQueueableSharedPointer<tBuffer, 0>(buffer));
+    queue2.Enqueue(tQueueableSharedPointer<tBuffer, 2>(buffer));
+  }
+
+  void TestBoundedQueues()
+  {
+    RRLIB_UNIT_TESTS_EQUALITY(existing_buffers.load(), 0);
+    tQueue<tQueueableSharedPointer<tFullBuffer, 0>, tConcurrency::FULL, tDequeueMode::FIFO, true> queue0;
+    tQueue<tQueueableSharedPointer<tFullBuffer, 1>, tConcurrency::MULTIPLE_WRITERS, tDequeueMode::ALL, true> queue1;
+    queue0.SetMaxLength(3);
+    queue1.SetMaxLength(4);
+    RRLIB_UNIT_TESTS_EQUALITY(queue1.GetMaxLength(), 4);
+    for (int i = 0; i < 100; i++)
+    {
+      tQueueableSharedPointer<tFullBuffer> buffer(new tFullBuffer(i));
+      queue1.Enqueue(tQueueableSharedPointer<tFullBuffer, 1>(buffer));
+      queue0.Enqueue(buffer);
+    }
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Discarded objects must be released", existing_buffers.load() <= 8);
+    tQueueFragment<tQueueableSharedPointer<tFullBuffer, 1>> fragment = queue1.DequeueAll();
+    for (int i = 96; i < 100; i++)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(fragment.PopFront()->value, i);
+    }
+    RRLIB_UNIT_TESTS_ASSERT(fragment.Empty());
+  }
+
+  void TestConcurrentFanOut()
+  {
+    RRLIB_UNIT_TESTS_EQUALITY(existing_buffers.load(), 0);
+    const int cBUFFERS = 100000;
+    tQueue<tQueueableSharedPointer<tBuffer, 0>, tConcurrency::SINGLE_READER_AND_WRITER, tDequeueMode::FIFO> queue0;
+    tQueue<tQueueableSharedPointer<tBuffer, 1>, tConcurrency::SINGLE_READER_AND_WRITER, tDequeueMode::FIFO> queue1;
+    tQueue<tQueueableSharedPointer<tBuffer, 2>, tConcurrency::MULTIPLE_WRITERS, tDequeueMode::ALL> queue2;
+    std::atomic<int> sum0(0), sum1(0), sum2(0);
+    std::thread producer([&]()
+    {
+      for (int i = 0; i < cBUFFERS; i++)
+      {
+        tQueueableSharedPointer<tBuffer> buffer(new tBuffer(1));
+        queue1.Enqueue(tQueueableSharedPointer<tBuffer, 1>(buffer));
+        queue2.Enqueue(tQueueableSharedPointer<tBuffer, 2>(buffer));
+        queue0.Enqueue(buffer);
+      }
+    });
+    std::thread consumer0([&]()
+    {
+      while (sum0.load() < cBUFFERS)
+      {
+        tQueueableSharedPointer<tBuffer, 0> buffer = queue0.Dequeue();
+        sum0 += buffer ? buffer->value : 0;
+      }
+    });
+    std::thread consumer1([&]()
+    {
+      while (sum1.load() < cBUFFERS)
+      {
+        tQueueableSharedPointer<tBuffer, 1> buffer = queue1.Dequeue();
+        sum1 += buffer ? buffer->value : 0;
+      }
+    });
+    std::thread consumer2([&]()
+    {
+      while (sum2.load() < cBUFFERS)
+      {
+        tQueueFragment<tQueueableSharedPointer<tBuffer, 2>> fragment = queue2.DequeueAll();
+        while (tQueueableSharedPointer<tBuffer, 2> buffer = fragment.PopAny())
+        {
+          sum2 += buffer->value;
+        }
+      }
+    });
+    producer.join();
+    consumer0.join();
+    consumer1.join();
+    consumer2.join();
+    RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Objects must be deleted after all consumers released them", existing_buffers.load(), 0);
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(SharedPointerQueueTest);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,185 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/tests/slab_allocator_test.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * Tests tSlabAllocator - with elements that are passed between threads via queues.
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages.h"
+#include "rrlib/util/tUnitTestSuite.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tQueue.h"
+#include "rrlib/concurrent_containers/tSlabAllocator.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+/*! Number of existing message objects */
+std::atomic<int> existing_messages(0);
+
+struct tMessage : public tQueueable<tQueueability::MOST>
+{
+  explicit tMessage(int value) : value(value)
+  {
+    existing_messages++;
+  }
+  ~tMessage()
+  {
+    existing_messages--;
+  }
+
+  int value;
+};
+
+typedef tSlabAllocator<tMessage, 32, 8> tMessageAllocator;
+
+class SlabAllocatorTest : public util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(SlabAllocatorTest);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestReuse);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestProducerConsumer);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestQueueFragments);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+  void TestReuse()
+  {
+    tMessage* address = NULL;
+    {
+      tMessageAllocator::tPointer message = tMessageAllocator::Create(1);
+      address = message.get();
+      RRLIB_UNIT_TESTS_EQUALITY(message->value, 1);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(existing_messages.load(), 0);
+    tMessageAllocator::tPointer message = tMessageAllocator::Create(2);
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Recently freed block must be reused", message.get() == address);
+
+    std::vector<tMessageAllocator::tPointer> messages;
+    for (int i = 0; i < 1000; i++)
+    {
+      messages.push_back(tMessageAllocator::Create(i));
+    }
+    size_t slabs = tMessageAllocator::GetSlabCount();
+    messages.clear();
+    for (int i = 0; i < 1000; i++)
+    {
+      messages.push_back(tMessageAllocator::Create(i));
+    }
+    RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Freed blocks must be reused", tMessageAllocator::GetSlabCount(), slabs);
+    messages.clear();
+  }
+
+  void TestProducerConsumer()
+  {
+    const int cMESSAGES = 100000;
+    tQueue<tMessageAllocator::tPointer, tConcurrency::SINGLE_READER_AND_WRITER, tDequeueMode::FIFO> queue;
+    size_t slabs_before = tMessageAllocator::GetSlabCount();
+
+    std::thread producer([&queue]()
+    {
+      for (int i = 0; i < cMESSAGES; i++)
+      {
+        while (existing_messages.load() > 500)
+        {
+          std::this_thread::yield();
+        }
+        queue.Enqueue(tMessageAllocator::Create(i));
+      }
+    });
+
+    int expected = 0;
+    while (expected < cMESSAGES)
+    {
+      tMessageAllocator::tPointer message = queue.Dequeue();
+      if (message)
+      {
+        RRLIB_UNIT_TESTS_EQUALITY(message->value, expected);
+        expected++;
+      }
+    }
+    producer.join();
+    RRLIB_UNIT_TESTS_EQUALITY(existing_messages.load(), 0);
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Blocks freed on consumer thread must flow back to producer", tMessageAllocator::GetSlabCount() - slabs_before < 100);
+  }
+
+  void TestQueueFragments()
+  {
+    tQueue<tMessageAllocator::tPointer, tConcurrency::MULTIPLE_WRITERS, tDequeueMode::ALL> queue;
+    for (int round = 0; round < 100; round++)
+    {
+      for (int i = 0; i < 100; i++)
+      {
+        queue.Enqueue(tMessageAllocator::Create(i));
+      }
+      tQueueFragment<tMessageAllocator::tPointer> fragment = queue.DequeueAll();
+      RRLIB_UNIT_TESTS_EQUALITY(fragment.PopFront()->value, 0);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(existing_messages.load(), 0);
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(SlabAllocatorTest);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
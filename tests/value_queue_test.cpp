@@ -0,0 +1,197 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/concurrent_containers/tests/value_queue_test.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-18
+ *
+ * Tests queues with values that are stored inline in segments.
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages.h"
+#include "rrlib/util/tUnitTestSuite.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/concurrent_containers/tQueue.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace concurrent_containers
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+/*! Small event (as pushed by producers) */
+struct tEvent
+{
+  uint32_t producer;
+  uint32_t sequence_number;
+};
+
+template <tConcurrency CONCURRENCY, tDequeueMode DEQUEUE_MODE>
+void TestFifo()
+{
+  tQueue<int, CONCURRENCY, DEQUEUE_MODE> queue;
+  bool success = true;
+  queue.Dequeue(success);
+  RRLIB_UNIT_TESTS_ASSERT(!success);
+
+  // several segments - and recycled segments
+  int next_value = 0;
+  for (int round = 0; round < 10; round++)
+  {
+    for (int i = 0; i < 2500; i++)
+    {
+      queue.Enqueue(round * 2500 + i);
+    }
+    for (int i = 0; i < 2500; i++)
+    {
+      int value = queue.Dequeue(success);
+      RRLIB_UNIT_TESTS_ASSERT(success);
+      RRLIB_UNIT_TESTS_EQUALITY(value, next_value);
+      next_value++;
+    }
+    queue.Dequeue(success);
+    RRLIB_UNIT_TESTS_ASSERT(!success);
+  }
+}
+
+template <tConcurrency CONCURRENCY, int READERS>
+void TestConcurrentQueue()
+{
+  const int cWRITERS = 4;
+  const int cEVENTS_PER_WRITER = 200000;
+  tQueue<tEvent, CONCURRENCY, tDequeueMode::FIFO> queue;
+  std::vector<std::atomic<int>> received(cWRITERS * cEVENTS_PER_WRITER);
+  std::atomic<int> received_count(0);
+  std::atomic<bool> order_ok(true);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < cWRITERS; t++)
+  {
+    threads.emplace_back([&, t]()
+    {
+      for (int i = 0; i < cEVENTS_PER_WRITER; i++)
+      {
+        tEvent event = { static_cast<uint32_t>(t), static_cast<uint32_t>(i) };
+        queue.Enqueue(event);
+      }
+    });
+  }
+  for (int r = 0; r < READERS; r++)
+  {
+    threads.emplace_back([&]()
+    {
+      std::vector<int> last_received(cWRITERS, -1);
+      while (received_count.load() < cWRITERS * cEVENTS_PER_WRITER)
+      {
+        bool success = false;
+        tEvent event = queue.Dequeue(success);
+        if (success)
+        {
+          if (static_cast<int>(event.sequence_number) <= last_received[event.producer])
+          {
+            order_ok = false;
+          }
+          last_received[event.producer] = event.sequence_number;
+          received[event.producer * cEVENTS_PER_WRITER + event.sequence_number]++;
+          received_count++;
+        }
+      }
+    });
+  }
+  for (auto & thread : threads)
+  {
+    thread.join();
+  }
+  RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Events of each producer must be dequeued in order", order_ok.load());
+  for (auto & count : received)
+  {
+    RRLIB_UNIT_TESTS_EQUALITY(count.load(), 1);
+  }
+}
+
+class ValueQueueTest : public util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(ValueQueueTest);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestQueues);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestMultipleWriters);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestMultipleWritersAndReaders);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+  void TestQueues()
+  {
+    TestFifo<tConcurrency::NONE, tDequeueMode::FIFO>();
+    TestFifo<tConcurrency::SINGLE_READER_AND_WRITER, tDequeueMode::FIFO>();
+    TestFifo<tConcurrency::MULTIPLE_WRITERS, tDequeueMode::FIFO_FAST>();
+    TestFifo<tConcurrency::FULL, tDequeueMode::FIFO>();
+  }
+
+  void TestMultipleWriters()
+  {
+    TestConcurrentQueue<tConcurrency::MULTIPLE_WRITERS, 1>();
+  }
+
+  void TestMultipleWritersAndReaders()
+  {
+    TestConcurrentQueue<tConcurrency::FULL, 3>();
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(ValueQueueTest);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}